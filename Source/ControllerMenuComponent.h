@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+	ControllerMenuComponent.h
+	Created: 17 Oct 2026 2:52:14pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "OscObjectComponent.h"
+#include "PatLookAndFeel.h"
+
+//==============================================================================
+/*
+*/
+class ControllerMenuComponent
+	: public Component
+	, public Button::Listener
+	, public TextEditor::Listener
+{
+public:
+
+	ControllerMenuComponent(OscvstAudioProcessor& _audioProcessor)
+		: audioProcessor(_audioProcessor)
+		, addButton("addControllerObject", true)
+		, removeButton("removeControllerObject", false)
+		, destinationsButton(_audioProcessor.mapLock)
+	{
+		// SELECTORS
+		channelSelector.addItem("any", 1);
+		for (int i = 1; i <= 16; ++i)
+			channelSelector.addItem("ch " + String(i), i + 1);
+		channelSelector.setSelectedId(1, dontSendNotification);
+		channelSelector.onChange = [this]() { this->updateMode(); };
+		addAndMakeVisible(channelSelector);
+
+		for (int i = 0; i < 128; ++i)
+			controllerSelector.addItem("cc " + String(i), i + 1);
+		controllerSelector.setSelectedId(2, dontSendNotification);
+		controllerSelector.onChange = [this]() { this->updateMode(); };
+		addAndMakeVisible(controllerSelector);
+
+		addButton.addListener(this);
+		addAndMakeVisible(addButton);
+
+		removeButton.addListener(this);
+		addAndMakeVisible(removeButton);
+
+		// LABELS
+		pathLabel.setText("path", dontSendNotification);
+		loLabel.setText("lo", dontSendNotification);
+		hiLabel.setText("hi", dontSendNotification);
+		deadbandLabel.setText("deadband", dontSendNotification);
+		rateLabel.setText("max rate", dontSendNotification);
+		for (auto* label : { &pathLabel, &loLabel, &hiLabel, &deadbandLabel, &rateLabel })
+		{
+			label->setJustificationType(Justification::centred);
+			addChildComponent(label);
+		}
+
+		// INPUTS
+		pathInput.setInputRestrictions(0, String("/0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"));
+		for (auto* input : { &loInput, &hiInput, &deadbandInput, &rateInput })
+			input->setInputRestrictions(0, "0123456789.-");
+		for (auto* input : { &pathInput, &loInput, &hiInput, &deadbandInput, &rateInput })
+		{
+			input->setJustification(Justification::verticallyCentred);
+			input->addListener(this);
+			addChildComponent(input);
+		}
+
+		// TOGGLES
+		bit14Toggle.setButtonText("14 bit?");
+		bit14Toggle.addListener(this);
+		addChildComponent(bit14Toggle);
+
+		intToggle.setButtonText("int?");
+		intToggle.addListener(this);
+		addChildComponent(intToggle);
+
+		destinationsButton.setDestinations(&audioProcessor.osc.destinations);
+		addChildComponent(destinationsButton);
+
+		updateMode();
+	}
+
+	int getChannel() const
+	{
+		return channelSelector.getSelectedId() - 1;
+	}
+
+	int getController() const
+	{
+		return controllerSelector.getSelectedId() - 1;
+	}
+
+	void updateMode()
+	{
+		const auto it = audioProcessor.ccMap.find(getMidiOscKey(getChannel(), getController()));
+		ccObject = it != audioProcessor.ccMap.end() ? &it->second : nullptr;
+
+		const bool hasObject = ccObject != nullptr;
+		for (auto* c : std::initializer_list<Component*>{ &pathLabel, &loLabel, &hiLabel, &deadbandLabel, &rateLabel
+			, &pathInput, &loInput, &hiInput, &deadbandInput, &rateInput, &intToggle, &removeButton, &destinationsButton })
+		{
+			c->setVisible(hasObject);
+		}
+		bit14Toggle.setVisible(hasObject && ccObject->canBe14Bit());
+		addButton.setVisible(!hasObject);
+		destinationsButton.setTarget(hasObject ? &ccObject->destinations : nullptr);
+
+		if (!hasObject) return;
+
+		setInputText(pathInput, ccObject->path);
+		setInputText(loInput, String(ccObject->range.range.getStart()));
+		setInputText(hiInput, String(ccObject->range.range.getEnd()));
+		setInputText(deadbandInput, String(ccObject->deadband));
+		setInputText(rateInput, String(ccObject->maxRate));
+		bit14Toggle.setToggleState(ccObject->is14Bit, dontSendNotification);
+		intToggle.setToggleState(ccObject->range.isInt, dontSendNotification);
+	}
+
+	void buttonClicked(Button* b) override
+	{
+		if (b == &addButton)
+		{
+			audioProcessor.addControllerObject(getChannel(), getController(), "/oscvst/cc" + String(getController()));
+			updateMode();
+		}
+		else if (b == &removeButton)
+		{
+			audioProcessor.removeControllerObject(getChannel(), getController());
+			updateMode();
+		}
+		else if (ccObject)
+		{
+			const ScopedLock sl(audioProcessor.mapLock);
+
+			if (b == &bit14Toggle)
+			{
+				ccObject->is14Bit = bit14Toggle.getToggleState();
+			}
+			else if (b == &intToggle)
+			{
+				ccObject->range.isInt = intToggle.getToggleState();
+				ccObject->compile();
+			}
+		}
+	}
+
+	void updateInputs(TextEditor& e)
+	{
+		if (!ccObject) return;
+
+		const ScopedLock sl(audioProcessor.mapLock);
+		const String& text = e.getText();
+		const float val = CharacterFunctions::readDoubleValue(text.toUTF8());
+
+		if (&e == &pathInput)
+		{
+			if (!ccObject->setPath(text.isEmpty() ? "/oscvst/cc" : text))
+				setInputText(pathInput, ccObject->path);
+		}
+		else if (&e == &loInput)
+		{
+			ccObject->range.range.setStart(text.isEmpty() ? 0.0f : val);
+		}
+		else if (&e == &hiInput)
+		{
+			ccObject->range.range.setEnd(text.isEmpty() ? 1.0f : val);
+		}
+		else if (&e == &deadbandInput)
+		{
+			ccObject->deadband = jmax(0.0f, val);
+		}
+		else if (&e == &rateInput)
+		{
+			ccObject->maxRate = jmax(0.0f, val);
+		}
+	}
+
+	void textEditorReturnKeyPressed(TextEditor& e) override
+	{
+		updateInputs(e);
+	}
+
+	void textEditorEscapeKeyPressed(TextEditor& e) override
+	{
+		updateInputs(e);
+	}
+
+	void textEditorFocusLost(TextEditor& e) override
+	{
+		updateInputs(e);
+	}
+
+	void resized() override
+	{
+		auto row = [](Component& label, Component& input)
+		{
+			FlexBox fb;
+			fb.flexDirection = FlexBox::Direction::row;
+			fb.items.add(FlexItem(label).withFlex(1));
+			fb.items.add(FlexItem(input).withFlex(2).withMargin(4));
+			return fb;
+		};
+
+		FlexBox selectFb;
+		selectFb.flexDirection = FlexBox::Direction::row;
+		selectFb.items.add(FlexItem(channelSelector).withFlex(1).withMargin(4));
+		selectFb.items.add(FlexItem(controllerSelector).withFlex(1).withMargin(4));
+
+		FlexBox pathFb = row(pathLabel, pathInput);
+		FlexBox loFb = row(loLabel, loInput);
+		FlexBox hiFb = row(hiLabel, hiInput);
+		FlexBox deadbandFb = row(deadbandLabel, deadbandInput);
+		FlexBox rateFb = row(rateLabel, rateInput);
+
+		FlexBox toggleFb;
+		toggleFb.flexDirection = FlexBox::Direction::row;
+		toggleFb.items.add(FlexItem(bit14Toggle).withFlex(1));
+		toggleFb.items.add(FlexItem(intToggle).withFlex(1));
+		toggleFb.items.add(FlexItem(destinationsButton).withFlex(1).withMargin(4));
+
+		FlexBox mainFb;
+		mainFb.flexDirection = FlexBox::Direction::column;
+		for (auto* fb : { &selectFb, &pathFb, &loFb, &hiFb, &deadbandFb, &rateFb, &toggleFb })
+			mainFb.items.add(FlexItem(*fb).withFlex(1).withMaxHeight(40.0f));
+
+		mainFb.performLayout(getLocalBounds().withTrimmedLeft(28).toFloat());
+
+		// add/remove
+		removeButton.setBounds(8, 8, 16, 16);
+
+		addButton.setSize(32, 32);
+		addButton.setCentrePosition(getWidth() / 2, getHeight() / 2);
+	}
+
+private:
+
+	void setInputText(TextEditor& e, const String& text)
+	{
+		e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		e.setText(text, dontSendNotification);
+	}
+
+	OscvstAudioProcessor& audioProcessor;
+	OscControllerObject* ccObject{ nullptr };
+
+	ComboBox channelSelector, controllerSelector;
+	AddOrRemoveButton addButton, removeButton;
+	Label pathLabel, loLabel, hiLabel, deadbandLabel, rateLabel;
+	TextEditor pathInput, loInput, hiInput, deadbandInput, rateInput;
+	PatToggleButton bit14Toggle, intToggle;
+	DestinationsButton destinationsButton;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ControllerMenuComponent)
+};
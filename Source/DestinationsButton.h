@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+	DestinationsButton.h
+	Created: 17 Oct 2026 4:21:05pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "OscDestination.h"
+
+//==============================================================================
+/*
+	Shows which destinations a mapping sends to, clicking it opens a menu to
+	tick them on and off.
+*/
+class DestinationsButton : public TextButton
+{
+public:
+
+	DestinationsButton(CriticalSection& _mapLock)
+		: mapLock(_mapLock)
+	{
+		onClick = [this]() { this->showMenu(); };
+		updateText();
+	}
+
+	void setDestinations(const OwnedArray<OscDestination>* _destinations)
+	{
+		destinations = _destinations;
+		updateText();
+	}
+
+	void setTarget(uint32* _mask)
+	{
+		mask = _mask;
+		updateText();
+	}
+
+	void updateText()
+	{
+		if (!mask || !destinations)
+		{
+			setButtonText("to: -");
+			return;
+		}
+
+		StringArray numbers;
+		for (int i = 0; i < destinations->size(); ++i)
+		{
+			if (*mask & (1u << i)) numbers.add(String(i + 1));
+		}
+		setButtonText("to: " + (numbers.isEmpty() ? String("none") : numbers.joinIntoString(",")));
+	}
+
+private:
+
+	void showMenu()
+	{
+		if (!mask || !destinations) return;
+
+		PopupMenu m;
+		m.setLookAndFeel(&getLookAndFeel());
+		for (int i = 0; i < destinations->size(); ++i)
+		{
+			const auto* destination = (*destinations)[i];
+			m.addItem(i + 1, String(i + 1) + ": " + destination->address + ":" + String(destination->port), true, (*mask & (1u << i)) != 0);
+		}
+
+		const int result = m.show();
+		if (result <= 0) return;
+
+		{
+			const ScopedLock sl(mapLock);
+			*mask ^= 1u << (result - 1);
+		}
+		updateText();
+	}
+
+	CriticalSection& mapLock;
+	const OwnedArray<OscDestination>* destinations{ nullptr };
+	uint32* mask{ nullptr };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DestinationsButton)
+};
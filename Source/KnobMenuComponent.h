@@ -11,6 +11,120 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "PatLookAndFeel.h"
+#include "DestinationsButton.h"
+
+//==============================================================================
+// right click menu for streaming a knob on its own
+class KnobStreamMenu
+	: public Component
+	, public TextEditor::Listener
+{
+public:
+
+	KnobStreamMenu(OscvstAudioProcessor& _audioProcessor, const int _knob)
+		: audioProcessor(_audioProcessor)
+		, knob(_knob)
+		, knobStream(_audioProcessor.knobStreams[_knob])
+		, destinationsButton(_audioProcessor.mapLock)
+	{
+		pathLabel.setText("path", dontSendNotification);
+		deadbandLabel.setText("deadband", dontSendNotification);
+		rateLabel.setText("max rate", dontSendNotification);
+		for (auto* label : { &pathLabel, &deadbandLabel, &rateLabel })
+		{
+			label->setJustificationType(Justification::centred);
+			addAndMakeVisible(label);
+		}
+
+		pathInput.setInputRestrictions(0, String("/0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"));
+		deadbandInput.setInputRestrictions(0, "0123456789.");
+		rateInput.setInputRestrictions(0, "0123456789.");
+		for (auto* input : { &pathInput, &deadbandInput, &rateInput })
+		{
+			input->setJustification(Justification::verticallyCentred);
+			input->addListener(this);
+			input->setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+			addAndMakeVisible(input);
+		}
+		pathInput.setText(knobStream.path, dontSendNotification);
+		deadbandInput.setText(String(knobStream.deadband), dontSendNotification);
+		rateInput.setText(String(knobStream.maxRate), dontSendNotification);
+
+		destinationsButton.setDestinations(&audioProcessor.osc.destinations);
+		destinationsButton.setTarget(&knobStream.destinations);
+		addAndMakeVisible(destinationsButton);
+	}
+
+	void updateInputs(TextEditor& e)
+	{
+		const String& text = e.getText();
+
+		if (&e == &pathInput)
+		{
+			const ScopedLock sl(audioProcessor.mapLock);
+			if (!knobStream.setPath(text.isEmpty() ? "/oscvst/knob" + String(knob + 1) : text))
+			{
+				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+				e.setText(knobStream.path, dontSendNotification);
+			}
+		}
+		else if (&e == &deadbandInput)
+		{
+			audioProcessor.setKnobDeadband(knob, (float)CharacterFunctions::readDoubleValue(text.toUTF8()));
+		}
+		else if (&e == &rateInput)
+		{
+			const ScopedLock sl(audioProcessor.mapLock);
+			knobStream.maxRate = jmax(0.0f, (float)CharacterFunctions::readDoubleValue(text.toUTF8()));
+		}
+	}
+
+	void textEditorReturnKeyPressed(TextEditor& e) override
+	{
+		updateInputs(e);
+	}
+
+	void textEditorEscapeKeyPressed(TextEditor& e) override
+	{
+		updateInputs(e);
+	}
+
+	void textEditorFocusLost(TextEditor& e) override
+	{
+		updateInputs(e);
+	}
+
+	void resized() override
+	{
+		FlexBox mainFb;
+		mainFb.flexDirection = FlexBox::Direction::column;
+
+		FlexBox rows[3];
+		Label* labels[] = { &pathLabel, &deadbandLabel, &rateLabel };
+		TextEditor* inputs[] = { &pathInput, &deadbandInput, &rateInput };
+		for (int i = 0; i < 3; ++i)
+		{
+			rows[i].flexDirection = FlexBox::Direction::row;
+			rows[i].items.add(FlexItem(*labels[i]).withFlex(1));
+			rows[i].items.add(FlexItem(*inputs[i]).withFlex(2));
+			mainFb.items.add(FlexItem(rows[i]).withFlex(1));
+		}
+		mainFb.items.add(FlexItem(destinationsButton).withFlex(1).withMargin(2));
+
+		mainFb.performLayout(getLocalBounds().toFloat());
+	}
+
+private:
+	OscvstAudioProcessor& audioProcessor;
+	const int knob;
+	OscControllerObject& knobStream;
+
+	Label pathLabel, deadbandLabel, rateLabel;
+	TextEditor pathInput, deadbandInput, rateInput;
+	DestinationsButton destinationsButton;
+};
 
 //==============================================================================
 /*
@@ -21,6 +135,9 @@ public:
 
 	KnobMenuComponent()
 	{
+		streamToggle.setButtonText("stream?");
+		addAndMakeVisible(streamToggle);
+
 		for (int i = 0; i < 16; ++i)
 		{
 			knobs.add(new Slider(String(i + 1)));
@@ -30,19 +147,37 @@ public:
 			knob->setSliderStyle(Slider::SliderStyle::RotaryVerticalDrag);
 			knob->setTextBoxStyle(Slider::NoTextBox, true, 0, 0);
 			knob->setRange(0.0, 1.0f);
+			knob->addMouseListener(this, false);
+		}
+	}
+
+	void mouseDown(const MouseEvent& e) override
+	{
+		if (!e.mods.isRightButtonDown() || !onKnobRightClicked) return;
+
+		for (int i = 0; i < knobs.size(); ++i)
+		{
+			if (e.eventComponent == knobs[i])
+			{
+				onKnobRightClicked(i);
+				return;
+			}
 		}
 	}
 
 	void resized() override
 	{
-		const int quarterY = (int)floor((float)getHeight() / 4.0f);
+		const int toggleHeight = 20;
+		streamToggle.setBounds(0, 0, getWidth(), toggleHeight);
+
+		const int quarterY = (int)floor((float)(getHeight() - toggleHeight) / 4.0f);
 		const int unitX = (int)floor((float)getWidth() / 4.0f);
 
 		for (int i = 0; i < 16; ++i)
 		{
 			knobs[i]->setBounds(
 				unitX * (i % 4)
-				, (int)floor(i / 4.0f) * quarterY
+				, toggleHeight + (int)floor(i / 4.0f) * quarterY
 				, unitX
 				, quarterY
 			);
@@ -50,6 +185,8 @@ public:
 	}
 
 	OwnedArray<Slider> knobs;
+	PatToggleButton streamToggle;
+	std::function<void(const int)> onKnobRightClicked;
 
 private:
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(KnobMenuComponent)
@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+
+	OscAudioAnalysis.h
+	Created: 18 Oct 2026 1:12:54am
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "OscEncoding.h"
+
+//==============================================================================
+/*
+	Measures the audio input for each report window: RMS and peak per channel,
+	and the RMS of each frequency band from a bank of band-pass filters spread
+	evenly on a log scale. The bank runs every band side by side, one sample at
+	a time, with the coefficients, filter state and energies laid out band by
+	band, so the inner loops have no dependencies between bands and compile to
+	SIMD. Nothing is allocated after construction.
+*/
+class OscAudioAnalyser
+{
+public:
+
+	static constexpr int maxChannels = 2;
+	static constexpr int maxBands = 16;
+
+	struct Frame
+	{
+		int numChannels{ 0 };
+		int numBands{ 0 };
+		std::array<float, maxChannels> rms{};
+		std::array<float, maxChannels> peak{};
+		std::array<std::array<float, maxBands>, maxChannels> bands{};
+		int sampleOffset{ 0 }; // where in the block the window ended
+		int64 timestamp{ 0 }; // high resolution ticks when the block entered the plugin
+		int64 playTicks{ 0 }; // high resolution ticks when the window ended
+	};
+
+	void prepare(const double _sampleRate)
+	{
+		sampleRate = jmax(1.0, _sampleRate);
+		numBands = 0; // the next process() sets up the filters
+		prepared = true;
+		reset();
+	}
+
+	void reset()
+	{
+		for (auto& channel : state)
+		{
+			channel.z1.fill(0.0f);
+			channel.z2.fill(0.0f);
+		}
+
+		sumSquares.fill(0.0);
+		peaks.fill(0.0f);
+		for (auto& channel : bandSumSquares) channel.fill(0.0);
+		windowPos = 0;
+	}
+
+	// AUDIO THREAD, calls report(Frame&) every time a window fills up
+	template <typename Callback>
+	void process(const float* const* channels, const int _numChannels, const int numSamples
+		, const int reportsPerSecond, const int _numBands, const float lowHz, const float highHz, Callback&& report)
+	{
+		const ScopedNoDenormals noDenormals;
+
+		const int numChannels = jmin(_numChannels, maxChannels);
+		if (numChannels <= 0 || !prepared) return;
+
+		if (_numBands != numBands || lowHz != bandsLowHz || highHz != bandsHighHz)
+			setBands(jlimit(0, maxBands, _numBands), lowHz, highHz);
+
+		const int windowSize = jmax(1, roundToInt(sampleRate / jlimit(1, 1000, reportsPerSecond)));
+
+		for (int start = 0; start < numSamples;)
+		{
+			const int num = jmin(numSamples - start, windowSize - windowPos);
+
+			for (int c = 0; c < numChannels; ++c)
+			{
+				const float* src = channels[c] + start;
+
+				const auto range = FloatVectorOperations::findMinAndMax(src, num);
+				peaks[(size_t)c] = jmax(peaks[(size_t)c], -range.getStart(), range.getEnd());
+				sumSquares[(size_t)c] += getSumOfSquares(src, num);
+
+				if (numBands > 0)
+					filterBands(state[(size_t)c], src, num, bandSumSquares[(size_t)c]);
+			}
+
+			start += num;
+			windowPos += num;
+
+			if (windowPos >= windowSize)
+			{
+				Frame frame;
+				frame.numChannels = numChannels;
+				frame.numBands = numBands;
+				frame.sampleOffset = start;
+
+				const double scale = 1.0 / windowPos;
+				for (int c = 0; c < numChannels; ++c)
+				{
+					frame.rms[(size_t)c] = (float)std::sqrt(sumSquares[(size_t)c] * scale);
+					frame.peak[(size_t)c] = peaks[(size_t)c];
+					for (int b = 0; b < numBands; ++b)
+						frame.bands[(size_t)c][(size_t)b] = (float)std::sqrt(bandSumSquares[(size_t)c][(size_t)b] * scale);
+				}
+				report(frame);
+
+				sumSquares.fill(0.0);
+				peaks.fill(0.0f);
+				for (auto& channel : bandSumSquares) channel.fill(0.0);
+				windowPos = 0;
+			}
+		}
+	}
+
+private:
+	// filter state for every band of one channel
+	struct BandState
+	{
+		alignas(16) std::array<float, maxBands> z1{};
+		alignas(16) std::array<float, maxBands> z2{};
+	};
+
+	// eight running sums so the loop vectorises without reordering a single sum
+	static double getSumOfSquares(const float* src, const int num)
+	{
+		constexpr int numLanes = 8;
+		float lanes[numLanes] = {};
+
+		int i = 0;
+		for (; i + numLanes <= num; i += numLanes)
+			for (int l = 0; l < numLanes; ++l)
+				lanes[l] += src[i + l] * src[i + l];
+
+		float sum = 0.0f;
+		for (int l = 0; l < numLanes; ++l)
+			sum += lanes[l];
+		for (; i < num; ++i)
+			sum += src[i] * src[i];
+		return (double)sum;
+	}
+
+	// transposed direct form II biquads, one per band, across all bands at once
+	// (the unused bands have zero coefficients and stay silent)
+	void filterBands(BandState& bandState, const float* src, const int num, std::array<double, maxBands>& sums) const
+	{
+		alignas(16) float z1[maxBands], z2[maxBands], energy[maxBands] = {};
+		std::copy(bandState.z1.begin(), bandState.z1.end(), z1);
+		std::copy(bandState.z2.begin(), bandState.z2.end(), z2);
+
+		const float* b0 = coefficients.b0.data();
+		const float* b1 = coefficients.b1.data();
+		const float* b2 = coefficients.b2.data();
+		const float* a1 = coefficients.a1.data();
+		const float* a2 = coefficients.a2.data();
+
+		for (int i = 0; i < num; ++i)
+		{
+			const float x = src[i];
+			for (int b = 0; b < maxBands; ++b)
+			{
+				const float y = b0[b] * x + z1[b];
+				z1[b] = b1[b] * x - a1[b] * y + z2[b];
+				z2[b] = b2[b] * x - a2[b] * y;
+				energy[b] += y * y;
+			}
+		}
+
+		std::copy(z1, z1 + maxBands, bandState.z1.begin());
+		std::copy(z2, z2 + maxBands, bandState.z2.begin());
+		for (int b = 0; b < maxBands; ++b)
+			sums[(size_t)b] += (double)energy[b];
+	}
+
+	// each band covers the same ratio of frequencies, with the Q to meet its neighbours
+	void setBands(const int _numBands, const float lowHz, const float highHz)
+	{
+		numBands = _numBands;
+		bandsLowHz = lowHz;
+		bandsHighHz = highHz;
+
+		for (auto* k : { &coefficients.b0, &coefficients.b1, &coefficients.b2, &coefficients.a1, &coefficients.a2 })
+			k->fill(0.0f);
+		for (auto& channel : state)
+		{
+			channel.z1.fill(0.0f);
+			channel.z2.fill(0.0f);
+		}
+		for (auto& channel : bandSumSquares) channel.fill(0.0);
+
+		if (numBands == 0) return;
+
+		const double nyquist = sampleRate * 0.5;
+		const double lo = jlimit(1.0, nyquist * 0.9, (double)lowHz);
+		const double hi = jlimit(lo * 1.01, nyquist * 0.9, (double)highHz);
+		const double ratio = std::pow(hi / lo, 1.0 / numBands);
+		const double q = std::sqrt(ratio) / (ratio - 1.0);
+
+		for (int b = 0; b < numBands; ++b)
+		{
+			const double centre = lo * std::pow(ratio, b + 0.5);
+			const auto k = IIRCoefficients::makeBandPass(sampleRate, centre, q);
+			coefficients.b0[(size_t)b] = (float)k.coefficients[0];
+			coefficients.b1[(size_t)b] = (float)k.coefficients[1];
+			coefficients.b2[(size_t)b] = (float)k.coefficients[2];
+			coefficients.a1[(size_t)b] = (float)k.coefficients[3];
+			coefficients.a2[(size_t)b] = (float)k.coefficients[4];
+		}
+	}
+
+	double sampleRate{ 44100.0 };
+	bool prepared{ false };
+	int numBands{ 0 };
+	float bandsLowHz{ 0.0f };
+	float bandsHighHz{ 0.0f };
+
+	// FILTER BANK, band by band
+	struct
+	{
+		alignas(16) std::array<float, maxBands> b0{}, b1{}, b2{}, a1{}, a2{};
+	} coefficients;
+	std::array<BandState, maxChannels> state;
+
+	// CURRENT WINDOW
+	std::array<double, maxChannels> sumSquares{};
+	std::array<float, maxChannels> peaks{};
+	std::array<std::array<double, maxBands>, maxChannels> bandSumSquares{};
+	int windowPos{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE(OscAudioAnalyser)
+};
+
+//==============================================================================
+/*
+	One message per channel on <path>/<channel> with the arguments rms, peak
+	and then one float per band, low to high. Encoded up front, only the
+	arguments are written per message.
+*/
+class OscAudioAnalysisPublisher
+{
+public:
+
+	OscAudioAnalysisPublisher()
+	{
+		setPath("/oscvst/audio");
+	}
+
+	bool setPath(const String& _path)
+	{
+		const String newPath = (_path.startsWith("/") ? _path : String("/") + _path).trimCharactersAtEnd("/");
+		if (!OscEncoding::isValidAddress(newPath + "/1")) return false;
+
+		path = newPath;
+
+		// the addresses only change here, compile() just rewrites what follows them
+		for (int c = 0; c < OscAudioAnalyser::maxChannels; ++c)
+		{
+			const String address = path + "/" + String(c + 1);
+			const auto addressSize = (int)address.getNumBytesAsUTF8();
+			typeTagsOffsets[(size_t)c] = OscEncoding::getPaddedSize(addressSize);
+
+			auto& message = messages[(size_t)c];
+			message.assign((size_t)(typeTagsOffsets[(size_t)c] + maxTypeTagsSize + maxArgsSize), 0);
+			OscEncoding::writeString(message.data(), address.toRawUTF8(), addressSize);
+		}
+
+		compile(numBands);
+		return true;
+	}
+
+	const String& getPath() const
+	{
+		return path;
+	}
+
+	// DISPATCH THREAD
+	const char* render(const int channel, const OscAudioAnalyser::Frame& frame)
+	{
+		if (frame.numBands != numBands) compile(frame.numBands);
+
+		auto& message = messages[(size_t)channel];
+		char* args = message.data() + argOffsets[(size_t)channel];
+		OscEncoding::writeFloat32(args, frame.rms[(size_t)channel]);
+		OscEncoding::writeFloat32(args + 4, frame.peak[(size_t)channel]);
+		for (int b = 0; b < numBands; ++b)
+			OscEncoding::writeFloat32(args + 8 + b * 4, frame.bands[(size_t)channel][(size_t)b]);
+
+		return message.data();
+	}
+
+	int getEncodedSize(const int channel) const
+	{
+		return sizes[(size_t)channel];
+	}
+
+private:
+	static constexpr int maxTypeTagsSize = (OscAudioAnalyser::maxBands + 3 + 4) & ~3;
+	static constexpr int maxArgsSize = (2 + OscAudioAnalyser::maxBands) * 4;
+
+	// the messages keep room for every band, so changing the number of bands doesn't allocate
+	void compile(const int _numBands)
+	{
+		numBands = jlimit(0, OscAudioAnalyser::maxBands, _numBands);
+
+		char typeTags[OscAudioAnalyser::maxBands + 4] = ",ff";
+		for (int b = 0; b < numBands; ++b)
+			typeTags[3 + b] = 'f';
+		const int numTypeTags = 3 + numBands;
+
+		for (int c = 0; c < OscAudioAnalyser::maxChannels; ++c)
+		{
+			const int typeTagsOffset = typeTagsOffsets[(size_t)c];
+			const int argOffset = typeTagsOffset + OscEncoding::writeString(messages[(size_t)c].data() + typeTagsOffset, typeTags, numTypeTags);
+			argOffsets[(size_t)c] = argOffset;
+			sizes[(size_t)c] = argOffset + (2 + numBands) * 4;
+		}
+	}
+
+	String path;
+	int numBands{ 8 };
+	std::array<std::vector<char>, OscAudioAnalyser::maxChannels> messages;
+	std::array<int, OscAudioAnalyser::maxChannels> typeTagsOffsets{};
+	std::array<int, OscAudioAnalyser::maxChannels> argOffsets{};
+	std::array<int, OscAudioAnalyser::maxChannels> sizes{};
+};
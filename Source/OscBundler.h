@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+	OscBundler.h
+	Created: 17 Oct 2026 11:48:05am
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "OscEncoding.h"
+#include "OscTransport.h"
+
+//==============================================================================
+/*
+	Collects the encoded messages of one flush and sends them as bundles that
+	never exceed the mtu. Messages are packed greedily in order, so the split is
+	deterministic. An mtu of 0 sends every message on its own. Everything is
+	queued on the transport, the owner submits it once the flush is done.
+	Timetagged messages always go in a bundle, only with others of the same
+	timetag.
+*/
+class OscBundler
+{
+public:
+
+	OscBundler(OscTransport& _transport)
+		: transport(_transport)
+	{}
+
+	// only allocates when the mtu grows
+	void setMtu(const int _mtu)
+	{
+		mtu = jmax(0, _mtu);
+		if ((int)buffer.size() < mtu) buffer.resize((size_t)mtu);
+	}
+
+	void add(const char* data, const int size, const uint64 timeTag = OscEncoding::immediately)
+	{
+		const int elementSize = OscEncoding::elementHeaderSize + size;
+		const bool fitsBundle = mtu > 0 && OscEncoding::bundleHeaderSize + elementSize <= mtu;
+
+		if (!fitsBundle && timeTag == OscEncoding::immediately)
+		{
+			// doesn't fit in any bundle, keep the order and send it on its own
+			flush();
+			transport.queue(data, size);
+			return;
+		}
+
+		if (numElements > 0 && (!fitsBundle || timeTag != bundleTimeTag || bundleSize + elementSize > mtu))
+			flush();
+
+		// a timetagged message bigger than the mtu still needs its bundle
+		if ((int)buffer.size() < bundleSize + elementSize)
+			buffer.resize((size_t)(bundleSize + elementSize));
+
+		if (numElements == 0)
+		{
+			OscEncoding::writeBundleHeader(buffer.data(), timeTag);
+			bundleTimeTag = timeTag;
+		}
+
+		char* dest = buffer.data() + bundleSize;
+		OscEncoding::writeInt32(dest, size);
+		std::memcpy(dest + OscEncoding::elementHeaderSize, data, (size_t)size);
+
+		bundleSize += elementSize;
+		++numElements;
+
+		if (!fitsBundle) flush();
+	}
+
+	void flush()
+	{
+		if (numElements == 1 && bundleTimeTag == OscEncoding::immediately)
+		{
+			// a bundle of one is just overhead
+			const int offset = OscEncoding::bundleHeaderSize + OscEncoding::elementHeaderSize;
+			transport.queue(buffer.data() + offset, bundleSize - offset);
+		}
+		else if (numElements > 0)
+		{
+			transport.queue(buffer.data(), bundleSize);
+			transport.getCounters().numBundles.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		numElements = 0;
+		bundleSize = OscEncoding::bundleHeaderSize;
+	}
+
+private:
+	OscTransport& transport;
+	int mtu{ 0 };
+
+	std::vector<char> buffer;
+	int bundleSize{ OscEncoding::bundleHeaderSize };
+	int numElements{ 0 };
+	uint64 bundleTimeTag{ OscEncoding::immediately };
+
+	JUCE_DECLARE_NON_COPYABLE(OscBundler)
+};
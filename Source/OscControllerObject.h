@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+	OscControllerObject.h
+	Created: 17 Oct 2026 2:10:58pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "OscObject.h"
+#include "OscEncoding.h"
+
+//==============================================================================
+/*
+	Streams one MIDI CC (or one knob) to an OSC path. Controllers 0-31 can be
+	paired with their LSB (controller + 32) for 14 bit resolution. All updates
+	within one flush collapse into the latest value, and values are only sent
+	when they moved past the deadband and the max rate allows it.
+*/
+struct OscControllerObject
+{
+	OscControllerObject() = default;
+
+	OscControllerObject(const int _channel, const int _controller, const String _path)
+		: channel(_channel)
+		, controller(_controller)
+	{
+		range.inUse = true;
+
+		if (!setPath(_path))
+		{
+			setPath("/oscvst/cc");
+		}
+	}
+
+	// invalid paths are rejected here rather than when sending
+	bool setPath(const String& _path)
+	{
+		const String newPath = _path.startsWith("/") ? _path : String("/") + _path;
+
+		if (!OscEncoding::isValidAddress(newPath))
+		{
+			return false;
+		}
+
+		path = newPath;
+		compile();
+		return true;
+	}
+
+	bool canBe14Bit() const
+	{
+		return controller < 32;
+	}
+
+	void compile()
+	{
+		const auto addressSize = (int)path.getNumBytesAsUTF8();
+		const int typeTagsOffset = OscEncoding::getPaddedSize(addressSize);
+		argOffset = typeTagsOffset + OscEncoding::getPaddedSize(2);
+
+		encoded.assign((size_t)(argOffset + 4), 0);
+		OscEncoding::writeString(encoded.data(), path.toRawUTF8(), addressSize);
+		OscEncoding::writeString(encoded.data() + typeTagsOffset, range.isInt ? ",i" : ",f", 2);
+	}
+
+	//==============================================================================
+	// DISPATCH THREAD, returns true if the controller needs to be flushed
+	bool update(const int number, const int value)
+	{
+		if (is14Bit && canBe14Bit())
+		{
+			if (number == controller)
+			{
+				msb = value;
+				lsb = 0; // a new MSB resets the LSB
+			}
+			else
+			{
+				lsb = value;
+			}
+			current = ((msb << 7) | lsb) / 16383.0f;
+		}
+		else
+		{
+			current = value / 127.0f;
+		}
+
+		return markDirty();
+	}
+
+	// DISPATCH THREAD, for values that are already 0-1
+	bool setValue(const float value)
+	{
+		current = value;
+		return markDirty();
+	}
+
+	enum class FlushResult
+	{
+		Unchanged,
+		Send,
+		Wait
+	};
+
+	FlushResult checkFlush(const double nowMs, double& waitMs)
+	{
+		// changes smaller than the deadband are skipped
+		const float change = std::abs(current - lastSent);
+		if (hasSent && (change == 0.0f || change < deadband))
+		{
+			dirty = false;
+			return FlushResult::Unchanged;
+		}
+
+		if (hasSent && maxRate > 0.0f)
+		{
+			const double due = lastSentMs + 1000.0 / maxRate;
+			if (nowMs < due)
+			{
+				waitMs = jmin(waitMs, due - nowMs);
+				return FlushResult::Wait;
+			}
+		}
+
+		return FlushResult::Send;
+	}
+
+	const char* render(const double nowMs)
+	{
+		lastSent = current;
+		lastSentMs = nowMs;
+		hasSent = true;
+		dirty = false;
+
+		if (range.isInt)
+			OscEncoding::writeInt32(encoded.data() + argOffset, (int)floor(range.getValue(current)) + 1);
+		else
+			OscEncoding::writeFloat32(encoded.data() + argOffset, range.getValue(current));
+
+		return encoded.data();
+	}
+
+	int getEncodedSize() const
+	{
+		return (int)encoded.size();
+	}
+
+	//==============================================================================
+	ValueTree toTree() const
+	{
+		ValueTree tree("ccObject");
+
+		tree.setProperty("path", path, nullptr);
+		tree.setProperty("channel", channel, nullptr);
+		tree.setProperty("controller", controller, nullptr);
+		tree.setProperty("is14Bit", is14Bit, nullptr);
+		tree.setProperty("deadband", deadband, nullptr);
+		tree.setProperty("maxRate", maxRate, nullptr);
+		tree.setProperty("destinations", (int)destinations, nullptr);
+		tree.addChild(range.toTree("range"), 0, nullptr);
+
+		return tree;
+	}
+
+	int channel{ 0 }; // 0 = any channel
+	int controller{ 1 };
+	String path;
+	bool is14Bit{ false };
+	float deadband{ 0.0f }; // in 0-1 controller units
+	float maxRate{ 0.0f }; // messages per second, 0 = unlimited
+	uint32 destinations{ 1 }; // one bit per destination
+	OscObject::OscObjectRange range;
+
+	bool dirty{ false };
+	int64 timestamp{ 0 }; // of the oldest event waiting to be sent
+	int64 playTicks{ 0 }; // of the latest value
+
+private:
+	bool markDirty()
+	{
+		const bool wasDirty = dirty;
+		dirty = true;
+		return !wasDirty;
+	}
+
+	int msb{ 0 };
+	int lsb{ 0 };
+	float current{ 0.0f };
+	float lastSent{ 0.0f };
+	double lastSentMs{ 0.0 };
+	bool hasSent{ false };
+
+	std::vector<char> encoded;
+	int argOffset{ 0 };
+};
+//==============================================================================
+using MidiCcOscMap = std::map<int, OscControllerObject>; // key, OscControllerObject
@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+	OscDestination.h
+	Created: 17 Oct 2026 3:58:12pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "OscPacketPool.h"
+#include "OscTransport.h"
+#include "OscTcpTransport.h"
+#include "OscLocalTransport.h"
+#include "OscBundler.h"
+#include "OscDispatchThread.h"
+#include "OscLatencyHistogram.h"
+#include "OscTimingWheel.h"
+
+//==============================================================================
+/*
+	One place to send OSC to. Each destination has its own socket, queue and
+	sender thread, so a slow or unreachable host can't hold up the others.
+	Settings changes are only picked up by the sender thread, so connecting
+	never blocks the message thread. Packets with a release time are held in
+	a timing wheel until then, shifted by the destination's own offset.
+*/
+class OscDestination
+{
+public:
+
+	enum class Protocol
+	{
+		Udp,
+		Tcp,
+		SharedMemory, // the address is the shared memory name
+		UnixSocket // the address is the socket path
+	};
+
+	static bool isLocal(const Protocol p)
+	{
+		return p == Protocol::SharedMemory || p == Protocol::UnixSocket;
+	}
+
+	OscDestination(OscPacketPool& _pool)
+		: pool(_pool)
+		, thread([this]() { return this->flush(); }, "Oscvst destination")
+	{
+		queue.prepare(queueSize);
+		sentTicks.reserve((size_t)wheelSize);
+	}
+
+	~OscDestination()
+	{
+		thread.stop();
+
+		int index;
+		while (queue.pop(index))
+		{
+			pool.release(index);
+		}
+
+		wheel.drain([this](const Held& held) { pool.release(held.index); });
+	}
+
+	// the sender thread reconnects on its next flush
+	void connect()
+	{
+		needsReconnect.store(true);
+		thread.wake();
+	}
+
+	void setAddress(const String& _address, const int _port)
+	{
+		{
+			const ScopedLock sl(lock);
+			address = _address;
+			port = _port;
+		}
+		connect();
+	}
+
+	void setMulticast(const OscMulticastOptions& options)
+	{
+		{
+			const ScopedLock sl(lock);
+			multicast = options;
+		}
+		connect();
+	}
+
+	void setProtocol(const Protocol _protocol)
+	{
+		{
+			const ScopedLock sl(lock);
+			protocol = _protocol;
+		}
+		connect();
+	}
+
+	void setBundling(const bool _useBundles, const int _mtu)
+	{
+		const ScopedLock sl(lock);
+		useBundles = _useBundles;
+		mtu = jlimit(0, OscEncoding::maxPacketSize, _mtu);
+	}
+
+	static constexpr int maxOffsetMs = 1000;
+
+	// ms, later messages are held back, earlier ones need the plugin to report latency
+	void setOffset(const int _offset)
+	{
+		{
+			const ScopedLock sl(lock);
+			offset = jlimit(-maxOffsetMs, maxOffsetMs, _offset);
+		}
+		thread.wake();
+	}
+
+	void start(const bool realtime, const uint32 affinityMask)
+	{
+		thread.start(realtime, affinityMask);
+		thread.wake();
+	}
+
+	// DISPATCH THREAD, the packet stays in the pool until this destination has sent it
+	bool enqueue(const int index)
+	{
+		pool.addRef(index);
+		if (!queue.push(index))
+		{
+			pool.release(index);
+			numDropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+
+	void wake()
+	{
+		thread.wake();
+	}
+
+	uint32 getNumDropped() const
+	{
+		return numDropped.load(std::memory_order_relaxed);
+	}
+
+	OscTransportCounters& getCounters()
+	{
+		return counters;
+	}
+
+	//==============================================================================
+	ValueTree toTree() const
+	{
+		ValueTree tree("destination");
+
+		tree.setProperty("address", address, nullptr);
+		tree.setProperty("port", port, nullptr);
+		tree.setProperty("useBundles", useBundles, nullptr);
+		tree.setProperty("mtu", mtu, nullptr);
+		tree.setProperty("offset", offset, nullptr);
+		tree.setProperty("protocol", (int)protocol, nullptr);
+		tree.setProperty("multicastTtl", multicast.ttl, nullptr);
+		tree.setProperty("multicastInterface", multicast.interfaceAddress, nullptr);
+		tree.setProperty("multicastLoopback", multicast.loopback, nullptr);
+
+		return tree;
+	}
+
+	void fromTree(const ValueTree& tree)
+	{
+		setBundling(tree.getProperty("useBundles", useBundles), tree.getProperty("mtu", mtu));
+		setProtocol((Protocol)(int)tree.getProperty("protocol", (int)protocol));
+		setOffset(tree.getProperty("offset", offset));
+
+		OscMulticastOptions options;
+		options.ttl = tree.getProperty("multicastTtl", multicast.ttl);
+		options.interfaceAddress = tree.getProperty("multicastInterface", multicast.interfaceAddress);
+		options.loopback = tree.getProperty("multicastLoopback", multicast.loopback);
+		setMulticast(options);
+		setAddress(tree.getProperty("address", address), tree.getProperty("port", port));
+	}
+
+	String address = "127.0.0.1";
+	int port = 1234;
+	bool useBundles = false;
+	int mtu = 1472; // bytes per bundle
+	Protocol protocol = Protocol::Udp;
+	OscMulticastOptions multicast;
+	int offset = 0; // ms
+
+	// LATENCY, written by the sender thread
+	OscLatencyHistogram sendLatency; // packet pool or release time -> socket write
+	OscLatencyHistogram totalLatency; // entering processBlock -> socket write
+
+private:
+
+	// SENDER THREAD
+	int flush()
+	{
+		String currentAddress;
+		int currentPort, currentMtu, currentOffset;
+		Protocol currentProtocol;
+		OscMulticastOptions currentMulticast;
+		{
+			const ScopedLock sl(lock);
+			currentMulticast = multicast;
+			currentAddress = address;
+			currentPort = jmax(0, port);
+			currentMtu = useBundles ? mtu : 0;
+			currentProtocol = protocol;
+			currentOffset = offset;
+		}
+
+		if (needsReconnect.exchange(false) || !transport)
+		{
+			if (!transport || currentProtocol != transportProtocol)
+			{
+				bundler.reset();
+				switch (currentProtocol)
+				{
+				case Protocol::Tcp:
+					transport = std::make_unique<OscTcpTransport>(counters);
+					break;
+				case Protocol::SharedMemory:
+					transport = std::make_unique<OscSharedMemoryTransport>(counters);
+					break;
+				case Protocol::UnixSocket:
+					transport = std::make_unique<OscUnixSocketTransport>(counters);
+					break;
+				default:
+					transport = std::make_unique<OscUdpTransport>(counters);
+					break;
+				}
+				bundler = std::make_unique<OscBundler>(*transport);
+				transportProtocol = currentProtocol;
+			}
+			transport->setMulticastOptions(currentMulticast);
+			transport->connect(currentAddress, currentPort);
+		}
+
+		bundler->setMtu(currentMtu);
+
+		const int64 now = Time::getHighResolutionTicks();
+		const int64 offsetTicks = msToTicks(currentOffset);
+
+		// held packets whose time has come go first, they were queued before anything new
+		wheel.advance(ticksToWheel(now), [this](const Held& held) { send(held.index, held.dueTicks); });
+
+		int index;
+		while (queue.pop(index))
+		{
+			const int64 releaseTicks = pool.getReleaseTicks(index);
+			const int64 dueTicks = releaseTicks != 0 ? releaseTicks + offsetTicks : 0;
+
+			// a full wheel sends straight away rather than dropping
+			if (dueTicks > now && wheel.insert(ticksToWheel(dueTicks) + 1, { index, dueTicks }))
+				continue;
+
+			send(index, 0);
+		}
+
+		bundler->flush();
+		transport->submit();
+
+		// tcp may still be holding some of it, but this is when the socket got it
+		const int64 sentNow = Time::getHighResolutionTicks();
+		for (const auto& ticks : sentTicks)
+		{
+			totalLatency.recordTicks(ticks.first, sentNow);
+			sendLatency.recordTicks(ticks.second, sentNow);
+		}
+		sentTicks.clear();
+
+		const int msUntilSubmit = transport->getMsUntilNextSubmit();
+		const int msUntilHeld = (int)wheel.getTicksUntilNext();
+		if (msUntilHeld < 0) return msUntilSubmit;
+		if (msUntilSubmit < 0) return msUntilHeld;
+		return jmin(msUntilSubmit, msUntilHeld);
+	}
+
+	// SENDER THREAD, held packets count their latency from when they were due
+	void send(const int index, const int64 dueTicks)
+	{
+		bundler->add(pool.getData(index), pool.getSize(index), pool.getTimeTag(index));
+		sentTicks.push_back({ pool.getEventTicks(index), jmax(pool.getEncodedTicks(index), dueTicks) });
+		pool.release(index);
+	}
+
+	// the wheel turns once a millisecond
+	static int64 ticksToWheel(const int64 ticks)
+	{
+		return (int64)(Time::highResolutionTicksToSeconds(ticks) * 1000.0);
+	}
+
+	static int64 msToTicks(const int ms)
+	{
+		return (int64)(ms * 0.001 * (double)Time::getHighResolutionTicksPerSecond());
+	}
+
+	struct Held
+	{
+		int index{ -1 };
+		int64 dueTicks{ 0 };
+	};
+
+	static constexpr int queueSize = 1024;
+	static constexpr int wheelSize = 4096; // as many as the processor's packet pool
+
+	OscPacketPool& pool;
+	CriticalSection lock; // settings vs the sender thread
+	std::atomic<bool> needsReconnect{ true };
+	OscTransportCounters counters;
+	std::unique_ptr<OscTransport> transport; // sender thread only
+	std::unique_ptr<OscBundler> bundler;
+	Protocol transportProtocol{ Protocol::Udp };
+	OscSpscQueue<int> queue;
+	OscTimingWheel<Held> wheel{ wheelSize }; // sender thread only
+	std::vector<std::pair<int64, int64>> sentTicks; // event, encoded
+	std::atomic<uint32> numDropped{ 0 };
+	OscDispatchThread thread;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscDestination)
+};
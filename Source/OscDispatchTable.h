@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+	OscDispatchTable.h
+	Created: 17 Oct 2026 1:26:40pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <map>
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+	Flat channel x number lookup for the dispatch thread, rebuilt from a map
+	keyed by getMidiOscKey() whenever it changes. Any channel mappings are
+	expanded into every channel first so that channel specific ones can
+	override them, which keeps find() to a single load.
+
+	Entries point at the mapping itself rather than holding a copy of its
+	compiled message, destinations and quantise. Rendering writes into the
+	mapping's own message and random state, and the editor changes the
+	destinations and quantise in place without a rebuild, so a copy would
+	go stale. A hit is one 8 byte load from a 16 KB table, and only mapped
+	notes go on to touch the mapping.
+*/
+template <typename ObjectType>
+class OscDispatchTable
+{
+public:
+
+	OscDispatchTable()
+	{
+		entries.fill(nullptr);
+	}
+
+	// call with the map locked, pointers stay valid until the map changes again
+	void rebuild(std::map<int, ObjectType>& map)
+	{
+		entries.fill(nullptr);
+
+		for (auto& p : map)
+		{
+			if (p.first / numNumbers != 0) continue;
+
+			for (int channel = 1; channel <= numChannels; ++channel)
+				entries[getIndex(channel, p.first % numNumbers)] = &p.second;
+		}
+
+		for (auto& p : map)
+		{
+			if (p.first / numNumbers == 0) continue;
+
+			entries[getIndex(p.first / numNumbers, p.first % numNumbers)] = &p.second;
+		}
+	}
+
+	// channel is 1-16, number is the note or controller
+	ObjectType* find(const int channel, const int number) const
+	{
+		return entries[getIndex(channel, number)];
+	}
+
+private:
+	static constexpr int numChannels = 16;
+	static constexpr int numNumbers = 128;
+
+	static int getIndex(const int channel, const int number)
+	{
+		return ((channel - 1) & (numChannels - 1)) * numNumbers + (number & (numNumbers - 1));
+	}
+
+	std::array<ObjectType*, numChannels * numNumbers> entries;
+
+	JUCE_DECLARE_NON_COPYABLE(OscDispatchTable)
+};
@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+	OscDispatchThread.h
+	Created: 17 Oct 2026 11:02:47am
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <JuceHeader.h>
+
+#if JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#elif JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#else
+ #include <cerrno>
+ #include <ctime>
+ #include <semaphore.h>
+#endif
+
+//==============================================================================
+/*
+	A counting semaphore straight from the OS, so signal() can be called from
+	the audio thread. Thread::notify() goes through a WaitableEvent, which
+	takes a mutex the waiting thread may be holding, these don't: a Linux
+	semaphore is a futex, a dispatch semaphore only enters the kernel when
+	someone is waiting, and a Windows semaphore is a single kernel call.
+*/
+class OscWakeSignal
+{
+public:
+
+	OscWakeSignal()
+	{
+	   #if JUCE_MAC || JUCE_IOS
+		semaphore = dispatch_semaphore_create(0);
+	   #elif JUCE_WINDOWS
+		semaphore = CreateSemaphore(nullptr, 0, 0x7fffffff, nullptr);
+	   #else
+		sem_init(&semaphore, 0, 0);
+	   #endif
+	}
+
+	~OscWakeSignal()
+	{
+	   #if JUCE_MAC || JUCE_IOS
+		dispatch_release(semaphore);
+	   #elif JUCE_WINDOWS
+		CloseHandle(semaphore);
+	   #else
+		sem_destroy(&semaphore);
+	   #endif
+	}
+
+	// never blocks
+	void signal()
+	{
+	   #if JUCE_MAC || JUCE_IOS
+		dispatch_semaphore_signal(semaphore);
+	   #elif JUCE_WINDOWS
+		ReleaseSemaphore(semaphore, 1, nullptr);
+	   #else
+		sem_post(&semaphore);
+	   #endif
+	}
+
+	// false if nothing signalled within the timeout
+	bool wait(const int timeoutMs)
+	{
+	   #if JUCE_MAC || JUCE_IOS
+		return dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)timeoutMs * 1000000)) == 0;
+	   #elif JUCE_WINDOWS
+		return WaitForSingleObject(semaphore, (DWORD)timeoutMs) == WAIT_OBJECT_0;
+	   #else
+		timespec deadline;
+		clock_gettime(CLOCK_REALTIME, &deadline);
+		deadline.tv_sec += timeoutMs / 1000;
+		deadline.tv_nsec += (long)(timeoutMs % 1000) * 1000000;
+		if (deadline.tv_nsec >= 1000000000)
+		{
+			++deadline.tv_sec;
+			deadline.tv_nsec -= 1000000000;
+		}
+
+		int result;
+		while ((result = sem_timedwait(&semaphore, &deadline)) != 0 && errno == EINTR) {}
+		return result == 0;
+	   #endif
+	}
+
+private:
+   #if JUCE_MAC || JUCE_IOS
+	dispatch_semaphore_t semaphore;
+   #elif JUCE_WINDOWS
+	HANDLE semaphore;
+   #else
+	sem_t semaphore;
+   #endif
+
+	JUCE_DECLARE_NON_COPYABLE(OscWakeSignal)
+};
+
+//==============================================================================
+/*
+	Sleeps until the audio thread calls wake(), optionally waits for the batch
+	window so that close events go out together, then calls the flush callback.
+	The callback returns how many ms until it wants to run again, or -1.
+*/
+class OscDispatchThread : public Thread
+{
+public:
+
+	OscDispatchThread(std::function<int()> _flushCallback, const String& threadName = "Oscvst dispatch")
+		: Thread(threadName)
+		, flushCallback(_flushCallback)
+	{}
+
+	~OscDispatchThread() override
+	{
+		stop();
+	}
+
+	void start(const bool realtime, const uint32 affinityMask)
+	{
+		stop();
+
+		wakePending.store(false);
+		setAffinityMask(affinityMask != 0 ? affinityMask : ~(uint32)0);
+		startThread(realtime ? 10 : 5);
+	}
+
+	// the run loop waits on wakeSignal rather than the thread's own event, so it's woken here too
+	void stop()
+	{
+		signalThreadShouldExit();
+		wakeSignal.signal();
+		stopThread(1000);
+	}
+
+	// safe to call from the audio thread, never locks and only signals once per wake up
+	void wake()
+	{
+		if (!wakePending.exchange(true, std::memory_order_acq_rel))
+			wakeSignal.signal();
+	}
+
+	void setBatchWindow(const int microseconds)
+	{
+		batchWindow.store(jmax(0, microseconds));
+	}
+
+	void run() override
+	{
+		int timeout = idleTimeoutMs;
+
+		while (!threadShouldExit())
+		{
+			// the idle timeout only catches events that were queued without a wake up
+			wakeSignal.wait(timeout);
+			if (threadShouldExit()) break;
+
+			const int window = batchWindow.load();
+			if (window > 0 && wakePending.load())
+				std::this_thread::sleep_for(std::chrono::microseconds(window));
+
+			wakePending.store(false, std::memory_order_release);
+
+			const int next = flushCallback ? flushCallback() : -1;
+			timeout = next >= 0 ? jmin(next, idleTimeoutMs) : idleTimeoutMs;
+		}
+	}
+
+private:
+	static constexpr int idleTimeoutMs = 100;
+
+	std::function<int()> flushCallback;
+	OscWakeSignal wakeSignal;
+	std::atomic<bool> wakePending{ false };
+	std::atomic<int> batchWindow{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscDispatchThread)
+};
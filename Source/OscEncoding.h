@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+	OscEncoding.h
+	Created: 17 Oct 2026 12:31:19pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Raw OSC 1.0 encoding, everything is big endian and padded to 4 bytes.
+namespace OscEncoding
+{
+	constexpr int bundleHeaderSize = 16; // "#bundle\0" + timetag
+	constexpr int elementHeaderSize = 4;
+	constexpr uint64 immediately = 1;
+
+	// the biggest message or bundle Oscvst builds, messages are kept to it by
+	// limiting the address, every message's type tags and arguments fit in the rest
+	constexpr int maxPacketSize = 4096;
+	constexpr int maxAddressSize = maxPacketSize - 256;
+
+	// size of a string including its null terminator, padded to 4 bytes
+	inline int getPaddedSize(const int numChars)
+	{
+		return (numChars + 4) & ~3;
+	}
+
+	inline void writeInt32(char* dest, const int32 value)
+	{
+		const auto v = (uint32)value;
+		dest[0] = (char)(v >> 24);
+		dest[1] = (char)(v >> 16);
+		dest[2] = (char)(v >> 8);
+		dest[3] = (char)v;
+	}
+
+	inline void writeFloat32(char* dest, const float value)
+	{
+		uint32 bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		writeInt32(dest, (int32)bits);
+	}
+
+	inline void writeUInt64(char* dest, const uint64 value)
+	{
+		writeInt32(dest, (int32)(uint32)(value >> 32));
+		writeInt32(dest + 4, (int32)(uint32)value);
+	}
+
+	// writes the string and its padding, returns the number of bytes written
+	inline int writeString(char* dest, const char* text, const int numChars)
+	{
+		const int size = getPaddedSize(numChars);
+		std::memcpy(dest, text, (size_t)numChars);
+		std::memset(dest + numChars, 0, (size_t)(size - numChars));
+		return size;
+	}
+
+	inline void writeBundleHeader(char* dest, const uint64 timeTag)
+	{
+		std::memcpy(dest, "#bundle", 8);
+		writeUInt64(dest + 8, timeTag);
+	}
+
+	// SLIP (RFC 1055) framing for OSC 1.1 over streams, the frame starts with an
+	// END too so that anything left over from a broken connection is thrown away
+	constexpr char slipEnd = (char)0xc0;
+	constexpr char slipEsc = (char)0xdb;
+	constexpr char slipEscEnd = (char)0xdc;
+	constexpr char slipEscEsc = (char)0xdd;
+
+	inline void appendSlipFrame(std::vector<char>& dest, const char* data, const int size)
+	{
+		dest.push_back(slipEnd);
+		for (int i = 0; i < size; ++i)
+		{
+			const char c = data[i];
+			if (c == slipEnd)
+			{
+				dest.push_back(slipEsc);
+				dest.push_back(slipEscEnd);
+			}
+			else if (c == slipEsc)
+			{
+				dest.push_back(slipEsc);
+				dest.push_back(slipEscEsc);
+			}
+			else
+			{
+				dest.push_back(c);
+			}
+		}
+		dest.push_back(slipEnd);
+	}
+
+	// addresses are checked with JUCE's own rules, so anything accepted here is sendable
+	inline bool isValidAddress(const String& address)
+	{
+		if ((int)address.getNumBytesAsUTF8() > maxAddressSize) return false;
+
+		try
+		{
+			OSCAddressPattern pattern(address);
+			return true;
+		}
+		catch (const OSCFormatError&)
+		{
+			return false;
+		}
+	}
+}
@@ -0,0 +1,346 @@
+/*
+  ==============================================================================
+
+	OscEventQueue.h
+	Created: 17 Oct 2026 10:12:31am
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include <JuceHeader.h>
+
+//==============================================================================
+using OscKnobValues = std::array<float, 16>;
+
+//==============================================================================
+struct OscEvent
+{
+	enum class Type : uint8
+	{
+		NoteOn,
+		NoteOff,
+		Controller,
+		PitchBend,
+		PolyAftertouch,
+		ChannelPressure,
+		ProgramChange,
+		Knob,
+		Reseed // playback started, mappings with a seed start their numbers again
+	};
+
+	static OscEvent noteOn(const int channel, const int note, const float velocity, const int sampleOffset)
+	{
+		OscEvent e;
+		e.type = Type::NoteOn;
+		e.channel = (uint8)channel;
+		e.note = (uint8)note;
+		e.value = velocity;
+		e.rawValue = (uint16)roundToInt(velocity * 127.0f);
+		e.sampleOffset = sampleOffset;
+		return e;
+	}
+
+	static OscEvent knob(const int index, const float value, const int sampleOffset)
+	{
+		OscEvent e;
+		e.type = Type::Knob;
+		e.channel = 0;
+		e.note = (uint8)index;
+		e.value = value;
+		e.sampleOffset = sampleOffset;
+		return e;
+	}
+
+	static OscEvent reseed(const int sampleOffset)
+	{
+		OscEvent e;
+		e.type = Type::Reseed;
+		e.channel = 0;
+		e.sampleOffset = sampleOffset;
+		return e;
+	}
+
+	// classifies one raw short MIDI message without building a MidiMessage, returns false for anything else
+	static bool fromMidi(const uint8* data, const int numBytes, const int sampleOffset, OscEvent& e)
+	{
+		if (numBytes < 2) return false;
+
+		const uint8 status = data[0] & 0xf0;
+		const uint8 data1 = data[1] & 0x7f;
+		const uint8 data2 = numBytes > 2 ? (data[2] & 0x7f) : 0;
+
+		e.channel = (uint8)((data[0] & 0x0f) + 1);
+		e.note = data1;
+		e.sampleOffset = sampleOffset;
+
+		switch (status)
+		{
+		case 0x90:
+			e.type = data2 != 0 ? Type::NoteOn : Type::NoteOff;
+			e.rawValue = data2;
+			e.value = data2 / 127.0f;
+			return numBytes > 2;
+
+		case 0x80:
+			e.type = Type::NoteOff;
+			e.rawValue = data2;
+			e.value = data2 / 127.0f;
+			return numBytes > 2;
+
+		case 0xa0:
+			e.type = Type::PolyAftertouch;
+			e.rawValue = data2;
+			e.value = data2 / 127.0f;
+			return numBytes > 2;
+
+		case 0xb0:
+			e.type = Type::Controller;
+			e.rawValue = data2;
+			e.value = data2 / 127.0f;
+			return numBytes > 2;
+
+		case 0xc0:
+			e.type = Type::ProgramChange;
+			e.rawValue = data1;
+			e.value = data1 / 127.0f;
+			return true;
+
+		case 0xd0:
+			e.type = Type::ChannelPressure;
+			e.note = 0;
+			e.rawValue = data1;
+			e.value = data1 / 127.0f;
+			return true;
+
+		case 0xe0:
+			e.type = Type::PitchBend;
+			e.note = 0;
+			e.rawValue = (uint16)(data1 | (data2 << 7));
+			e.value = e.rawValue / 16383.0f;
+			return numBytes > 2;
+
+		default:
+			return false;
+		}
+	}
+
+	// events with the same key describe the same source, so they can be coalesced
+	uint32 getKey() const
+	{
+		return ((uint32)type << 16) | ((uint32)channel << 8) | (uint32)note;
+	}
+
+	Type type{ Type::NoteOn };
+	uint8 channel{ 1 };
+	uint8 note{ 0 }; // note, controller, program or knob number
+	uint16 rawValue{ 0 }; // 7 bit value, or 14 bit for pitch bend
+	float value{ 0.0f }; // rawValue scaled to 0-1
+	int sampleOffset{ 0 };
+	int64 timestamp{ 0 }; // high resolution ticks when the event entered the plugin
+	int64 playTicks{ 0 }; // high resolution ticks when the event is heard, from its sample offset
+	OscKnobValues knobs{}; // note ons only, the knobs at the note's sample offset
+	double ppq{ -1.0 }; // note ons only, host position in quarter notes, -1 when not playing
+	double bpm{ 0.0 };
+};
+
+//==============================================================================
+/*
+	Bounded single producer (audio thread) / single consumer (sender) queue.
+	All memory is allocated in prepare(), push() never allocates or locks.
+	prepare() must not run while the consumer is popping.
+*/
+class OscEventQueue
+{
+public:
+
+	enum class OverflowPolicy
+	{
+		DropOldest,
+		DropNewest,
+		Coalesce
+	};
+
+	OscEventQueue() = default;
+
+	void prepare(const int capacity)
+	{
+		const int size = jmax(2, nextPowerOfTwo(capacity));
+
+		events.assign((size_t)size, OscEvent());
+		mask = (uint32)size - 1;
+		readPos.store(0);
+		writePos.store(0);
+
+		numCoalesced = 0;
+	}
+
+	int getCapacity() const
+	{
+		return (int)events.size();
+	}
+
+	int getNumReady() const
+	{
+		return (int)(writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_acquire));
+	}
+
+	// PRODUCER
+	bool push(const OscEvent& e)
+	{
+		if (events.empty()) return false;
+
+		// anything coalesced is older than this and has to go in first
+		if (numCoalesced > 0)
+		{
+			flushCoalesced();
+			if (numCoalesced > 0)
+			{
+				numOverflows.fetch_add(1, std::memory_order_relaxed);
+				return coalesce(e);
+			}
+		}
+
+		const uint32 w = writePos.load(std::memory_order_relaxed);
+		uint32 r = readPos.load(std::memory_order_acquire);
+
+		if (w - r > mask)
+		{
+			switch (policy.load(std::memory_order_relaxed))
+			{
+			case OverflowPolicy::DropNewest:
+				numOverflows.fetch_add(1, std::memory_order_relaxed);
+				return false;
+
+			case OverflowPolicy::Coalesce:
+				numOverflows.fetch_add(1, std::memory_order_relaxed);
+				return coalesce(e);
+
+			case OverflowPolicy::DropOldest:
+				// if this fails the consumer has just freed a slot for us
+				if (readPos.compare_exchange_strong(r, r + 1, std::memory_order_acq_rel))
+					numOverflows.fetch_add(1, std::memory_order_relaxed);
+				break;
+			}
+		}
+
+		events[w & mask] = e;
+		writePos.store(w + 1, std::memory_order_release);
+		return true;
+	}
+
+	// PRODUCER, moves coalesced events into the ring in the order they were first held back,
+	// as far as there is room. Call it once per block so they don't wait for the next push.
+	// True if anything moved.
+	bool flushCoalesced()
+	{
+		if (numCoalesced == 0) return false;
+
+		const uint32 w = writePos.load(std::memory_order_relaxed);
+		const uint32 r = readPos.load(std::memory_order_acquire);
+		const int numFree = (int)(mask + 1 - (w - r));
+		const int num = jmin(numCoalesced, numFree);
+		if (num <= 0) return false;
+
+		for (int i = 0; i < num; ++i)
+			events[(w + (uint32)i) & mask] = coalesceSlots[i].event;
+		writePos.store(w + (uint32)num, std::memory_order_release);
+
+		numCoalesced -= num;
+		for (int i = 0; i < numCoalesced; ++i)
+			coalesceSlots[i] = coalesceSlots[i + num];
+		return true;
+	}
+
+	// CONSUMER
+	bool pop(OscEvent& e)
+	{
+		if (events.empty()) return false;
+
+		uint32 r = readPos.load(std::memory_order_acquire);
+		for (;;)
+		{
+			if (r == writePos.load(std::memory_order_acquire))
+				return false;
+
+			e = events[r & mask];
+
+			// fails only if the producer dropped this event while we were copying it
+			if (readPos.compare_exchange_weak(r, r + 1, std::memory_order_acq_rel))
+				return true;
+		}
+	}
+
+	void setOverflowPolicy(const OverflowPolicy p)
+	{
+		policy.store(p);
+	}
+
+	OverflowPolicy getOverflowPolicy() const
+	{
+		return policy.load();
+	}
+
+	uint32 getNumOverflows() const
+	{
+		return numOverflows.load(std::memory_order_relaxed);
+	}
+
+	void resetNumOverflows()
+	{
+		numOverflows.store(0);
+	}
+
+private:
+
+	//==============================================================================
+	// When the ring is full the coalesce policy keeps only the latest event per key here,
+	// in the order each key was first held back. Only the producer touches them, they
+	// go back into the ring before anything newer.
+	struct CoalesceSlot
+	{
+		uint32 key{ 0 };
+		OscEvent event;
+	};
+
+	bool coalesce(const OscEvent& e)
+	{
+		const uint32 key = e.getKey();
+		for (int i = 0; i < numCoalesced; ++i)
+		{
+			if (coalesceSlots[i].key == key)
+			{
+				coalesceSlots[i].event = e;
+				return true;
+			}
+		}
+
+		if (numCoalesced == numCoalesceSlots) return false;
+
+		coalesceSlots[numCoalesced].key = key;
+		coalesceSlots[numCoalesced].event = e;
+		++numCoalesced;
+		return true;
+	}
+
+	//==============================================================================
+	static constexpr int numCoalesceSlots = 64;
+
+	std::vector<OscEvent> events;
+	uint32 mask{ 0 };
+	std::atomic<uint32> readPos{ 0 };
+	std::atomic<uint32> writePos{ 0 };
+
+	CoalesceSlot coalesceSlots[numCoalesceSlots];
+	int numCoalesced{ 0 };
+	std::atomic<OverflowPolicy> policy{ OverflowPolicy::DropOldest };
+	std::atomic<uint32> numOverflows{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE(OscEventQueue)
+};
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+	OscHostTransport.h
+	Created: 18 Oct 2026 12:48:20am
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "OscEncoding.h"
+
+//==============================================================================
+// One transport message, made on the audio thread and sent by the dispatch thread.
+struct OscHostTransportEvent
+{
+	enum class Type : uint8
+	{
+		Play,
+		Stop,
+		Tick
+	};
+
+	Type type{ Type::Tick };
+	bool isPlaying{ false };
+	int numerator{ 4 };
+	int denominator{ 4 };
+	int bar{ 1 }; // bar, beat and subdivision count from 1
+	int beat{ 1 };
+	int subdivision{ 1 };
+	double ppq{ 0.0 };
+	double bpm{ 120.0 };
+	int sampleOffset{ 0 };
+	int64 timestamp{ 0 }; // high resolution ticks when the block entered the plugin
+	int64 playTicks{ 0 }; // high resolution ticks when the tick is heard
+};
+
+//==============================================================================
+/*
+	Follows the host's playhead block by block and finds the play/stop changes
+	and the beat subdivisions that fall inside each block, to the sample. Hosts
+	only give the start of the current bar, so bar numbers assume the time
+	signature hasn't changed since the start of the song.
+*/
+class OscHostTransportTracker
+{
+public:
+
+	void reset()
+	{
+		wasPlaying = false;
+		lastTickPpq = noTick;
+	}
+
+	// AUDIO THREAD, calls emit(OscHostTransportEvent&) for everything in this block in order
+	template <typename Callback>
+	void process(const AudioPlayHead::CurrentPositionInfo& position, const double sampleRate, const int numSamples, const int subdivisions, Callback&& emit)
+	{
+		OscHostTransportEvent e;
+		e.isPlaying = position.isPlaying;
+		e.bpm = position.bpm;
+		e.numerator = jmax(1, position.timeSigNumerator);
+		e.denominator = jmax(1, position.timeSigDenominator);
+
+		const int perBeat = jmax(1, subdivisions);
+		const double beatLength = 4.0 / e.denominator; // in quarter notes
+		const double tickLength = beatLength / perBeat;
+		const double barStart = position.ppqPositionOfLastBarStart;
+
+		// PLAY / STOP
+		if (position.isPlaying != wasPlaying)
+		{
+			wasPlaying = position.isPlaying;
+			lastTickPpq = noTick;
+
+			e.type = position.isPlaying ? OscHostTransportEvent::Type::Play : OscHostTransportEvent::Type::Stop;
+			setPosition(e, position.ppqPosition, barStart, beatLength, tickLength, perBeat);
+			emit(e);
+		}
+
+		if (!position.isPlaying || position.bpm <= 0.0 || sampleRate <= 0.0) return;
+
+		// TICKS
+		const double ppqPerSample = position.bpm / (60.0 * sampleRate);
+		const double start = position.ppqPosition;
+		const double end = start + numSamples * ppqPerSample;
+
+		// looping or moving the playhead back starts counting again
+		if (start < lastTickPpq) lastTickPpq = noTick;
+
+		e.type = OscHostTransportEvent::Type::Tick;
+		for (double n = std::ceil((start - barStart) / tickLength - 1.0e-9); ; ++n)
+		{
+			const double ppq = barStart + n * tickLength;
+			if (ppq >= end) break;
+
+			// the end of the last block and the start of this one can round either way
+			if (ppq <= lastTickPpq + tickLength * 0.5) continue;
+
+			e.sampleOffset = jlimit(0, numSamples - 1, (int)std::floor((ppq - start) / ppqPerSample + 0.5));
+			setPosition(e, ppq, barStart, beatLength, tickLength, perBeat);
+			emit(e);
+			lastTickPpq = ppq;
+		}
+	}
+
+private:
+	static constexpr double noTick = -1.0e12;
+
+	static void setPosition(OscHostTransportEvent& e, const double ppq, const double barStart
+		, const double beatLength, const double tickLength, const int perBeat)
+	{
+		const double barLength = beatLength * e.numerator;
+		const int64 ticksPerBar = (int64)perBeat * e.numerator;
+		const int64 tick = (int64)std::floor((ppq - barStart) / tickLength + 1.0e-6);
+		const int64 barsFromStart = (int64)std::floor((double)tick / (double)ticksPerBar);
+		const int64 tickInBar = tick - barsFromStart * ticksPerBar;
+
+		e.ppq = ppq;
+		e.bar = (int)((int64)std::floor(barStart / barLength + 0.5) + barsFromStart + 1);
+		e.beat = (int)(tickInBar / perBeat) + 1;
+		e.subdivision = (int)(tickInBar % perBeat) + 1;
+	}
+
+	bool wasPlaying{ false };
+	double lastTickPpq{ noTick };
+};
+
+//==============================================================================
+/*
+	Encodes transport events as one message with the arguments
+	playing (0/1), bpm, time signature numerator and denominator, bar, beat,
+	subdivision and ppq position. Encoded once up front, only the arguments
+	are written per message.
+*/
+class OscHostTransportPublisher
+{
+public:
+
+	OscHostTransportPublisher()
+	{
+		setPath("/oscvst/transport");
+	}
+
+	bool setPath(const String& _path)
+	{
+		const String newPath = (_path.startsWith("/") ? _path : String("/") + _path).trimCharactersAtEnd("/");
+		if (!OscEncoding::isValidAddress(newPath)) return false;
+
+		path = newPath;
+
+		const auto addressSize = (int)path.getNumBytesAsUTF8();
+		const int typeTagsOffset = OscEncoding::getPaddedSize(addressSize);
+		argOffset = typeTagsOffset + OscEncoding::getPaddedSize(numArgs + 1);
+
+		message.assign((size_t)(argOffset + numArgs * 4), 0);
+		OscEncoding::writeString(message.data(), path.toRawUTF8(), addressSize);
+		OscEncoding::writeString(message.data() + typeTagsOffset, ",ifiiiiif", numArgs + 1);
+		return true;
+	}
+
+	const String& getPath() const
+	{
+		return path;
+	}
+
+	const char* render(const OscHostTransportEvent& e)
+	{
+		char* args = message.data() + argOffset;
+		OscEncoding::writeInt32(args, e.isPlaying ? 1 : 0);
+		OscEncoding::writeFloat32(args + 4, (float)e.bpm);
+		OscEncoding::writeInt32(args + 8, e.numerator);
+		OscEncoding::writeInt32(args + 12, e.denominator);
+		OscEncoding::writeInt32(args + 16, e.bar);
+		OscEncoding::writeInt32(args + 20, e.beat);
+		OscEncoding::writeInt32(args + 24, e.subdivision);
+		OscEncoding::writeFloat32(args + 28, (float)e.ppq);
+		return message.data();
+	}
+
+	int getEncodedSize() const
+	{
+		return (int)message.size();
+	}
+
+private:
+	static constexpr int numArgs = 8;
+
+	String path;
+	std::vector<char> message;
+	int argOffset{ 0 };
+};
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+	OscLatencyHistogram.h
+	Created: 17 Oct 2026 7:15:09pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+	Log scale histogram of microseconds, 8 linear steps per power of two so
+	percentiles are within 12.5%. Only one thread records into each histogram,
+	so recording is a relaxed load and store, the UI reads a snapshot.
+*/
+class OscLatencyHistogram
+{
+public:
+
+	struct Snapshot
+	{
+		uint64 count{ 0 };
+		double p50{ 0.0 };
+		double p99{ 0.0 };
+		double p999{ 0.0 };
+		double max{ 0.0 };
+	};
+
+	OscLatencyHistogram()
+	{
+		reset();
+	}
+
+	// RECORDING THREAD ONLY
+	void record(const double microseconds)
+	{
+		const auto us = (uint32)jlimit(0.0, (double)maxValue, microseconds);
+		auto& bucket = counts[(size_t)getBucket(us)];
+		bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+		if (us > maxSeen.load(std::memory_order_relaxed))
+			maxSeen.store(us, std::memory_order_relaxed);
+	}
+
+	void recordTicks(const int64 startTicks, const int64 endTicks)
+	{
+		if (startTicks == 0) return; // not stamped
+		record(Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1.0e6);
+	}
+
+	// from any thread, a sample recorded at the same moment may survive the reset
+	void reset()
+	{
+		for (auto& c : counts)
+			c.store(0, std::memory_order_relaxed);
+		maxSeen.store(0, std::memory_order_relaxed);
+	}
+
+	Snapshot getSnapshot() const
+	{
+		return combine({ this });
+	}
+
+	// percentiles over several histograms, i.e the same stage on every destination
+	static Snapshot combine(const Array<const OscLatencyHistogram*>& histograms)
+	{
+		std::array<uint64, numBuckets> total{};
+		uint32 max = 0;
+
+		for (const auto* h : histograms)
+		{
+			for (int i = 0; i < numBuckets; ++i)
+				total[(size_t)i] += h->counts[(size_t)i].load(std::memory_order_relaxed);
+			max = jmax(max, h->maxSeen.load(std::memory_order_relaxed));
+		}
+
+		return fromCounts(total, max);
+	}
+
+private:
+	static constexpr int subBits = 3;
+	static constexpr int numSub = 1 << subBits;
+	static constexpr int numPowers = 28; // up to ~4 minutes
+	static constexpr int numBuckets = (numPowers - subBits + 1) * numSub;
+	static constexpr uint32 maxValue = (1u << numPowers) - 1;
+
+	static int getBucket(const uint32 us)
+	{
+		if (us < (uint32)numSub) return (int)us;
+
+		int power = 0;
+		for (uint32 v = us; v > 1; v >>= 1) ++power;
+
+		const int sub = (int)((us >> (power - subBits)) & (numSub - 1));
+		return (power - subBits + 1) * numSub + sub;
+	}
+
+	// upper edge of a bucket in microseconds
+	static double getBucketValue(const int bucket)
+	{
+		if (bucket < numSub) return (double)bucket;
+
+		const int power = bucket / numSub + subBits - 1;
+		const int sub = bucket % numSub;
+		return (double)((uint64)(numSub + sub + 1) << (power - subBits)) - 1.0;
+	}
+
+	static Snapshot fromCounts(const std::array<uint64, numBuckets>& total, const uint32 max)
+	{
+		Snapshot s;
+		for (const auto c : total) s.count += c;
+		s.max = (double)max;
+		if (s.count == 0) return s;
+
+		auto percentile = [&](const double fraction)
+		{
+			const auto target = (uint64)std::ceil(fraction * (double)s.count);
+			uint64 seen = 0;
+			for (int i = 0; i < numBuckets; ++i)
+			{
+				seen += total[(size_t)i];
+				if (seen >= target) return jmin(getBucketValue(i), s.max);
+			}
+			return s.max;
+		};
+
+		s.p50 = percentile(0.5);
+		s.p99 = percentile(0.99);
+		s.p999 = percentile(0.999);
+		return s;
+	}
+
+	std::array<std::atomic<uint32>, numBuckets> counts;
+	std::atomic<uint32> maxSeen{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE(OscLatencyHistogram)
+};
@@ -0,0 +1,192 @@
+/*
+  ==============================================================================
+
+	OscLocalTransport.h
+	Created: 17 Oct 2026 6:05:44pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "OscTransport.h"
+#include "OscSharedMemoryRing.h"
+
+#if OSCVST_HAS_SHARED_MEMORY
+ #include <sys/socket.h>
+ #include <sys/un.h>
+ #include <cerrno>
+#endif
+
+//==============================================================================
+/*
+	For consumers on the same machine, skips the network stack. The address is
+	the shared memory name (i.e /oscvst) and the port is ignored.
+*/
+class OscSharedMemoryTransport : public OscTransport
+{
+public:
+
+	OscSharedMemoryTransport(OscTransportCounters& _counters)
+		: OscTransport(_counters)
+	{}
+
+	bool connect(const String& address, const int) override
+	{
+		disconnect();
+
+	   #if OSCVST_HAS_SHARED_MEMORY
+		const String name = address.startsWith("/") ? address : "/" + address;
+		return writer.open(name.toStdString());
+	   #else
+		ignoreUnused(address);
+		return false;
+	   #endif
+	}
+
+	void disconnect() override
+	{
+		clearQueue();
+
+	   #if OSCVST_HAS_SHARED_MEMORY
+		writer.close();
+	   #endif
+	}
+
+	bool isConnected() const override
+	{
+	   #if OSCVST_HAS_SHARED_MEMORY
+		return writer.isOpen();
+	   #else
+		return false;
+	   #endif
+	}
+
+	int submit() override
+	{
+		int numSent = 0;
+
+	   #if OSCVST_HAS_SHARED_MEMORY
+		if (writer.isOpen())
+		{
+			int numBytes = 0;
+			for (const auto& packet : packets)
+			{
+				if (writer.write(arena.data() + packet.offset, (uint32)packet.size))
+				{
+					++numSent;
+					numBytes += packet.size;
+				}
+			}
+
+			if (numSent > 0) counters.count(numSent, numBytes);
+			counters.readerLag.store(writer.getReaderLag(), std::memory_order_relaxed);
+			counters.numOverruns.store(writer.getNumOverruns(), std::memory_order_relaxed);
+		}
+	   #endif
+
+		counters.numDropped.fetch_add((uint32)((int)packets.size() - numSent), std::memory_order_relaxed);
+		clearQueue();
+		return numSent;
+	}
+
+private:
+   #if OSCVST_HAS_SHARED_MEMORY
+	OscSharedMemoryRing::Writer writer;
+   #endif
+
+	JUCE_DECLARE_NON_COPYABLE(OscSharedMemoryTransport)
+};
+
+//==============================================================================
+/*
+	UNIX domain datagram socket, the address is the receiver's socket path.
+	Never waits, packets the receiver has no room for are dropped.
+*/
+class OscUnixSocketTransport : public OscTransport
+{
+public:
+
+	OscUnixSocketTransport(OscTransportCounters& _counters)
+		: OscTransport(_counters)
+	{}
+
+	~OscUnixSocketTransport() override
+	{
+		disconnect();
+	}
+
+	bool connect(const String& address, const int) override
+	{
+		disconnect();
+
+	   #if OSCVST_HAS_SHARED_MEMORY
+		const auto path = address.toStdString();
+		if (path.empty() || path.size() >= sizeof(target.sun_path)) return false;
+
+		handle = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+		if (handle < 0) return false;
+
+		target = {};
+		target.sun_family = AF_UNIX;
+		std::memcpy(target.sun_path, path.c_str(), path.size() + 1);
+		return true;
+	   #else
+		ignoreUnused(address);
+		return false;
+	   #endif
+	}
+
+	void disconnect() override
+	{
+		clearQueue();
+
+	   #if OSCVST_HAS_SHARED_MEMORY
+		if (handle >= 0) ::close(handle);
+		handle = -1;
+	   #endif
+	}
+
+	bool isConnected() const override
+	{
+		return handle >= 0;
+	}
+
+	int submit() override
+	{
+		int numSent = 0;
+
+	   #if OSCVST_HAS_SHARED_MEMORY
+		if (handle >= 0)
+		{
+			for (const auto& packet : packets)
+			{
+				const auto result = ::sendto(handle, arena.data() + packet.offset, (size_t)packet.size, MSG_DONTWAIT
+					, (const sockaddr*)&target, (socklen_t)sizeof(target));
+
+				if (result == packet.size)
+				{
+					counters.count(1, packet.size);
+					++numSent;
+				}
+			}
+		}
+	   #endif
+
+		counters.numSendErrors.fetch_add((uint32)((int)packets.size() - numSent), std::memory_order_relaxed);
+		clearQueue();
+		return numSent;
+	}
+
+private:
+	int handle{ -1 };
+
+   #if OSCVST_HAS_SHARED_MEMORY
+	sockaddr_un target{};
+   #endif
+
+	JUCE_DECLARE_NON_COPYABLE(OscUnixSocketTransport)
+};
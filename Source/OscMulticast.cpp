@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+	OscMulticast.cpp
+	Created: 17 Oct 2026 6:48:27pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+// socket options JUCE's DatagramSocket doesn't expose, kept out of the headers
+// so the platform socket headers don't clash with JUCE's names
+
+#if defined(_WIN32)
+ #include <winsock2.h>
+ #include <ws2tcpip.h>
+ typedef DWORD MulticastOptionType;
+#else
+ #include <sys/socket.h>
+ #include <netinet/in.h>
+ #include <arpa/inet.h>
+ typedef unsigned char MulticastOptionType;
+#endif
+
+#include <cstring>
+
+bool oscvstSetMulticastOptions(const int handle, const int ttl, const char* interfaceAddress, const bool loopback)
+{
+	bool ok = true;
+
+	const MulticastOptionType ttlValue = (MulticastOptionType)(ttl < 0 ? 0 : (ttl > 255 ? 255 : ttl));
+	ok &= setsockopt(handle, IPPROTO_IP, IP_MULTICAST_TTL, (const char*)&ttlValue, sizeof(ttlValue)) == 0;
+
+	const MulticastOptionType loopValue = loopback ? 1 : 0;
+	ok &= setsockopt(handle, IPPROTO_IP, IP_MULTICAST_LOOP, (const char*)&loopValue, sizeof(loopValue)) == 0;
+
+	if (interfaceAddress != nullptr && std::strlen(interfaceAddress) > 0)
+	{
+		in_addr address;
+		if (inet_pton(AF_INET, interfaceAddress, &address) == 1)
+			ok &= setsockopt(handle, IPPROTO_IP, IP_MULTICAST_IF, (const char*)&address, sizeof(address)) == 0;
+		else
+			ok = false;
+	}
+
+	return ok;
+}
@@ -11,8 +11,11 @@
 #pragma once
 
 #include <tuple>
+#include <array>
 
 #include "JuceHeader.h"
+#include "OscEncoding.h"
+#include "OscRandom.h"
 
 //==============================================================================
 struct OscObject
@@ -40,50 +43,133 @@ struct OscObject
 			return tree;
 		}
 	};
+
+	// beat grid that note ons wait for while the host is playing
+	enum class Quantise
+	{
+		Off,
+		Quarter,
+		Eighth,
+		Sixteenth,
+		QuarterTriplet,
+		EighthTriplet,
+		SixteenthTriplet
+	};
+
+	// in quarter notes
+	static double getGridLength(const Quantise q)
+	{
+		switch (q)
+		{
+		case Quantise::Quarter: return 1.0;
+		case Quantise::Eighth: return 0.5;
+		case Quantise::Sixteenth: return 0.25;
+		case Quantise::QuarterTriplet: return 2.0 / 3.0;
+		case Quantise::EighthTriplet: return 1.0 / 3.0;
+		case Quantise::SixteenthTriplet: return 1.0 / 6.0;
+		default: return 0.0;
+		}
+	}
 	//==============================================================================
 
 	OscObject() = default;
 
-	OscObject(Random* _random, const int _note, const String _path)
-		: random(_random)
+	OscObject(const int _channel, const int _note, const String _path)
+		: channel(_channel)
 		, note(_note)
 	{
-		setPath(_path);
-
 		for (int i = 0; i < 16; ++i)
 		{
 			knobRanges.emplace_back();
 		}
+
+		if (!setPath(_path))
+		{
+			setPath("/oscvst");
+		}
+
+		resetRandom();
 	}
 
-	void send(OSCSender& sender, const float vel, const std::vector<float>& knobValues)
+	// rebuilds the encoded message, call after changing the path or which arguments are used
+	void compile()
 	{
-		OSCMessage msg(path);
+		slots.clear();
+		String typeTags(",");
 
-		if (useNote) msg.addInt32(note);
-		if (useVel) msg.addFloat32(vel);
+		auto addSlot = [&](const Slot::Source source, const int knob, const bool isInt)
+		{
+			typeTags += isInt ? "i" : "f";
+			slots.push_back({ source, (uint8)knob, isInt, 4 * (int)slots.size() });
+		};
 
-		if (random && randomRange.inUse)
+		if (useNote) addSlot(Slot::Source::Note, 0, true);
+		if (useVel) addSlot(Slot::Source::Velocity, 0, false);
+		if (randomRange.inUse) addSlot(Slot::Source::Random, 0, randomRange.isInt);
+		for (int i = 0; i < knobRanges.size(); ++i)
 		{
-			if (randomRange.isInt)
-				msg.addInt32((int)floor(randomRange.getValue(random->nextFloat())) + 1);
-			else
-				msg.addFloat32(randomRange.getValue(random->nextFloat()));
+			if (knobRanges[i].inUse) addSlot(Slot::Source::Knob, i, knobRanges[i].isInt);
 		}
 
-		for (int i = 0; i < knobRanges.size(); ++i)
+		const auto addressSize = (int)path.getNumBytesAsUTF8();
+		const auto typeTagsSize = typeTags.length();
+		const int argsOffset = OscEncoding::getPaddedSize(addressSize) + OscEncoding::getPaddedSize(typeTagsSize);
+
+		encoded.assign((size_t)(argsOffset + 4 * (int)slots.size()), 0);
+		char* data = encoded.data();
+		data += OscEncoding::writeString(data, path.toRawUTF8(), addressSize);
+		OscEncoding::writeString(data, typeTags.toRawUTF8(), typeTagsSize);
+
+		for (auto& slot : slots)
 		{
-			const auto& knob = knobRanges[i];
-			if (knob.inUse)
+			slot.offset += argsOffset;
+			if (slot.source == Slot::Source::Note)
+				OscEncoding::writeInt32(encoded.data() + slot.offset, note);
+		}
+	}
+
+	// patches the current values into the encoded message, no allocation
+	const char* render(const float vel, const std::array<float, 16>& knobValues)
+	{
+		char* data = encoded.data();
+
+		for (const auto& slot : slots)
+		{
+			const OscObjectRange* range = nullptr;
+			float value = 0.0f;
+
+			switch (slot.source)
 			{
-				if (knob.isInt)
-					msg.addInt32((int)floor(knob.getValue(knobValues[i])) + 1);
-				else
-					msg.addFloat32(knob.getValue(knobValues[i]));
+			case Slot::Source::Note:
+				continue;
+
+			case Slot::Source::Velocity:
+				OscEncoding::writeFloat32(data + slot.offset, vel);
+				continue;
+
+			case Slot::Source::Random:
+				range = &randomRange;
+				value = nextRandom();
+				break;
+
+			case Slot::Source::Knob:
+				range = &knobRanges[slot.knob];
+				value = knobValues[slot.knob];
+				break;
 			}
+
+			if (slot.isInt)
+				OscEncoding::writeInt32(data + slot.offset, (int)floor(range->getValue(value)) + 1);
+			else
+				OscEncoding::writeFloat32(data + slot.offset, range->getValue(value));
 		}
 
-		sender.send(msg);
+		return data;
+	}
+
+	int getEncodedSize() const
+	{
+		return (int)encoded.size();
 	}
 
 	void addKnobToUse(const uint8 num)
@@ -91,6 +177,7 @@ struct OscObject
 		if (0 <= num && num < 16)
 		{
 			knobRanges[num].inUse = true;
+			compile();
 		}
 	}
 
@@ -99,6 +186,7 @@ struct OscObject
 		if (0 <= num && num < 16)
 		{
 			knobRanges[num].inUse = false;
+			compile();
 		}
 	}
 
@@ -114,14 +202,26 @@ struct OscObject
 		}
 	}
 
-	void setPath(const String& _path)
+	// starts the numbers again from the seed, or from a new seed when there isn't one
+	void resetRandom()
 	{
-		path = _path;
+		random.setSeed(seed != 0 ? (uint64)seed : OscRandom::makeSeed());
+		randomPos = randomBlockSize;
+	}
+
+	// invalid paths are rejected here rather than when sending
+	bool setPath(const String& _path)
+	{
+		const String newPath = _path.startsWith("/") ? _path : String("/") + _path;
 
-		if (!path.startsWith("/"))
+		if (!OscEncoding::isValidAddress(newPath))
 		{
-			path = String("/") + path;
+			return false;
 		}
+
+		path = newPath;
+		compile();
+		return true;
 	}
 
 	ValueTree toTree() const
@@ -129,9 +229,13 @@ struct OscObject
 		ValueTree tree("oscObject");
 
 		tree.setProperty("path", path, nullptr);
+		tree.setProperty("channel", channel, nullptr);
 		tree.setProperty("note", note, nullptr);
 		tree.setProperty("useNote", useNote, nullptr);
 		tree.setProperty("useVel", useVel, nullptr);
+		tree.setProperty("destinations", (int)destinations, nullptr);
+		tree.setProperty("seed", seed, nullptr);
+		tree.setProperty("quantise", (int)quantise, nullptr);
 		tree.addChild(randomRange.toTree("randomRange"), 0, nullptr);
 		for (int i = 0; i < knobRanges.size(); ++i)
 			tree.addChild(knobRanges[i].toTree(String("knob") + String(i+1)), 0, nullptr);
@@ -139,14 +243,59 @@ struct OscObject
 		return tree;
 	}
 
+	int channel{ 0 }; // 0 = any channel
 	int note{ 60 };
 	String path;
 	std::vector<OscObjectRange> knobRanges;
 	bool useNote{ true };
 	bool useVel{ true };
+	uint32 destinations{ 1 }; // one bit per destination
 	OscObjectRange randomRange;
+	int64 seed{ 0 }; // 0 = different numbers every time
+	Quantise quantise{ Quantise::Off };
+
+private:
+	static constexpr int randomBlockSize = 64;
 
-	Random* random{ nullptr };
+	// numbers are made a block at a time, only the dispatch thread takes them
+	float nextRandom()
+	{
+		if (randomPos == randomBlockSize)
+		{
+			random.fill(randomBlock.data(), randomBlockSize);
+			randomPos = 0;
+		}
+		return randomBlock[(size_t)randomPos++];
+	}
+
+	struct Slot
+	{
+		enum class Source : uint8
+		{
+			Note,
+			Velocity,
+			Random,
+			Knob
+		};
+
+		Source source;
+		uint8 knob;
+		bool isInt;
+		int offset;
+	};
+
+	std::vector<Slot> slots;
+	std::vector<char> encoded;
+
+	OscRandom random;
+	std::array<float, randomBlockSize> randomBlock;
+	int randomPos{ randomBlockSize };
 };
 //==============================================================================
-using MidiOscMap = std::map<int, OscObject>; // note, OscObject
\ No newline at end of file
+using MidiOscMap = std::map<int, OscObject>; // key, OscObject
+
+// channel 0 = any channel, so any channel keys are just the note
+inline int getMidiOscKey(const int channel, const int note)
+{
+	return channel * 128 + note;
+}
\ No newline at end of file
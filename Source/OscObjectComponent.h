@@ -12,6 +12,7 @@
 
 #include <JuceHeader.h>
 #include "OscObject.h"
+#include "DestinationsButton.h"
 #include "PatLookAndFeel.h"
 
 //==============================================================================
@@ -21,8 +22,9 @@ class RightClickMenu
 {
 public:
 
-	RightClickMenu(OscObject* _oscObject, PatToggleButton* button)
+	RightClickMenu(OscObject* _oscObject, CriticalSection& _mapLock, PatToggleButton* button)
 		: oscObject(_oscObject)
+		, mapLock(_mapLock)
 	{
 
 		switch (button->type)
@@ -48,7 +50,9 @@ public:
 		intToggle.setToggleState(oscRange->isInt, dontSendNotification);
 		intToggle.onStateChange = [this]()
 		{
+			const ScopedLock sl(mapLock);
 			oscRange->isInt = this->intToggle.getToggleState();
+			oscObject->compile();
 		};
 		addAndMakeVisible(intToggle);
 
@@ -70,10 +74,38 @@ public:
 			hiInput.setText(String(oscRange->range.getEnd()), dontSendNotification);
 			addAndMakeVisible(hiInput);
 		}
+
+		// SEED, empty = different numbers every time
+		if (oscRange == &oscObject->randomRange)
+		{
+			seedLabel.setText("seed", dontSendNotification);
+			seedLabel.setJustificationType(Justification::centred);
+			addAndMakeVisible(seedLabel);
+
+			seedInput.setInputRestrictions(18, "0123456789");
+			seedInput.setJustification(Justification::verticallyCentred);
+			seedInput.addListener(this);
+			seedInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+			seedInput.setText(oscObject->seed != 0 ? String(oscObject->seed) : String(), dontSendNotification);
+			addAndMakeVisible(seedInput);
+		}
+	}
+
+	bool hasSeed() const
+	{
+		return seedInput.isVisible();
 	}
 
 	void updateInputs(TextEditor& e)
 	{
+		if (&e == &seedInput)
+		{
+			const ScopedLock sl(mapLock);
+			oscObject->seed = e.getText().getLargeIntValue();
+			oscObject->resetRandom();
+			return;
+		}
+
 		String& text = e.getText();
 		float val;
 		const bool isLo = &e == &loInput;
@@ -89,6 +121,7 @@ public:
 			val = CharacterFunctions::readDoubleValue(e.getText().toUTF8());
 		}
 
+		const ScopedLock sl(mapLock);
 		if (isLo)
 			oscRange->range.setStart(val);
 		else
@@ -127,12 +160,20 @@ public:
 		mainFb.items.add(FlexItem(loFb).withFlex(1));
 		mainFb.items.add(FlexItem(hiFb).withFlex(1));
 		mainFb.items.add(FlexItem(intToggle).withFlex(1));
+
+		FlexBox seedFb;
+		seedFb.flexDirection = FlexBox::Direction::row;
+		seedFb.items.add(FlexItem(seedLabel).withFlex(1));
+		seedFb.items.add(FlexItem(seedInput).withFlex(3));
+		if (hasSeed()) mainFb.items.add(FlexItem(seedFb).withFlex(1));
+
 		mainFb.performLayout(getLocalBounds().toFloat());
 	}
 
 	OscObject* oscObject;
-	Label loLabel, hiLabel;
-	TextEditor loInput, hiInput;
+	CriticalSection& mapLock;
+	Label loLabel, hiLabel, seedLabel;
+	TextEditor loInput, hiInput, seedInput;
 	ToggleButton intToggle;
 
 	OscObject::OscObjectRange* oscRange;
@@ -173,10 +214,12 @@ public:
 
 	OscObjectComponent() = default;
 
-	OscObjectComponent(MidiOscMap& _oscMap)
+	OscObjectComponent(MidiOscMap& _oscMap, CriticalSection& _mapLock)
 		: oscMap(_oscMap)
+		, mapLock(_mapLock)
 		, addButton("addOscObject", true)
 		, removeButton("removeOscObject", false)
+		, destinationsButton(_mapLock)
 	{
 		setInterceptsMouseClicks(true, true);
 
@@ -218,20 +261,50 @@ public:
 		for (const auto& toggles : toggles)
 			addAndMakeVisible(toggles);
 
+		channelSelector.addItem("any", 1);
+		for (int i = 1; i <= 16; ++i)
+			channelSelector.addItem("ch " + String(i), i + 1);
+		channelSelector.setSelectedId(1, dontSendNotification);
+		channelSelector.onChange = [this]()
+		{
+			this->setChannel(channelSelector.getSelectedId() - 1);
+		};
+		addAndMakeVisible(channelSelector);
+
+		// QUANTISE, ids are the enum + 1
+		quantiseSelector.addItem("free", (int)OscObject::Quantise::Off + 1);
+		quantiseSelector.addItem("1/4", (int)OscObject::Quantise::Quarter + 1);
+		quantiseSelector.addItem("1/8", (int)OscObject::Quantise::Eighth + 1);
+		quantiseSelector.addItem("1/16", (int)OscObject::Quantise::Sixteenth + 1);
+		quantiseSelector.addItem("1/4T", (int)OscObject::Quantise::QuarterTriplet + 1);
+		quantiseSelector.addItem("1/8T", (int)OscObject::Quantise::EighthTriplet + 1);
+		quantiseSelector.addItem("1/16T", (int)OscObject::Quantise::SixteenthTriplet + 1);
+		quantiseSelector.onChange = [this]()
+		{
+			if (oscObject)
+			{
+				const ScopedLock sl(mapLock);
+				oscObject->quantise = (OscObject::Quantise)(quantiseSelector.getSelectedId() - 1);
+			}
+		};
+		addChildComponent(quantiseSelector);
+
+		addChildComponent(destinationsButton);
+
 		updateMode();
 	}
 
-	OscObjectComponent(MidiOscMap& _oscMap, OscObject* _oscObject) : OscObjectComponent(_oscMap)
+	OscObjectComponent(MidiOscMap& _oscMap, CriticalSection& _mapLock, OscObject* _oscObject) : OscObjectComponent(_oscMap, _mapLock)
 	{
 		oscObject = _oscObject;
 		updateMode();
 	}
 
-	OscObjectComponent(MidiOscMap& _oscMap, OscObject* _oscObject
+	OscObjectComponent(MidiOscMap& _oscMap, CriticalSection& _mapLock, OscObject* _oscObject
 		, std::function<OscObject* ()> _addOscObjectCallback
 		, std::function<void()> _removeOscObjectCallback
 	)
-		: OscObjectComponent(_oscMap, _oscObject)
+		: OscObjectComponent(_oscMap, _mapLock, _oscObject)
 	{
 		addOscObjectCallback = _addOscObjectCallback;
 		removeOscObjectCallback = _removeOscObjectCallback;
@@ -239,11 +312,11 @@ public:
 
 	void buttonRightClicked(PatToggleButton* b)
 	{
-		RightClickMenu cm(oscObject, b);
+		RightClickMenu cm(oscObject, mapLock, b);
 		PopupMenu m;
 		m.setLookAndFeel(&getLookAndFeel());
 		m.addItem(1, "close");
-		m.addCustomItem(2, cm, 100, 100, false);
+		m.addCustomItem(2, cm, 100, cm.hasSeed() ? 133 : 100, false);
 
 		const int result = m.show();
 	}
@@ -278,6 +351,12 @@ public:
 				}
 			}
 
+			destinationsButton.setTarget(&oscObject->destinations);
+			destinationsButton.setVisible(true);
+
+			quantiseSelector.setSelectedId((int)oscObject->quantise + 1, dontSendNotification);
+			quantiseSelector.setVisible(true);
+
 			addButton.setVisible(false);
 		}
 		else
@@ -290,6 +369,9 @@ public:
 			randomToggle.setVisible(false);
 			for (auto& toggle : toggles)
 				toggle->setVisible(false);
+			destinationsButton.setTarget(nullptr);
+			destinationsButton.setVisible(false);
+			quantiseSelector.setVisible(false);
 
 			addButton.setVisible(true);
 		}
@@ -316,7 +398,9 @@ public:
 		{
 			if (oscObject)
 			{
+				const ScopedLock sl(mapLock);
 				oscObject->useNote = noteToggle.getToggleState();
+				oscObject->compile();
 			}
 			return;
 		}
@@ -324,7 +408,9 @@ public:
 		{
 			if (oscObject)
 			{
+				const ScopedLock sl(mapLock);
 				oscObject->useVel = velToggle.getToggleState();
+				oscObject->compile();
 			}
 			return;
 		}
@@ -332,7 +418,9 @@ public:
 		{
 			if (oscObject)
 			{
+				const ScopedLock sl(mapLock);
 				oscObject->randomRange.inUse = randomToggle.getToggleState();
+				oscObject->compile();
 			}
 			return;
 		}
@@ -345,6 +433,7 @@ public:
 				{
 					if (oscObject)
 					{
+						const ScopedLock sl(mapLock);
 						if (b->getToggleState())
 						{
 							oscObject->addKnobToUse(num);
@@ -398,15 +487,27 @@ public:
 		// add/remove
 		removeButton.setBounds(8, 8, 16, 16);
 
+		// channel
+		channelSelector.setBounds(getWidth() - 68, 6, 60, 20);
+
+		// destinations
+		destinationsButton.setBounds(getWidth() - 136, 6, 64, 20);
+
+		// quantise
+		quantiseSelector.setBounds(getWidth() - 204, 6, 64, 20);
+
 		addButton.setSize(32, 32);
 		addButton.setCentrePosition(halfX, halfY);
 	}
 
-	void setMidi(const int note)
+	void setMidi(const int _note)
 	{
-		if (oscMap.count(note) == 1)
+		note = _note;
+
+		const int key = getMidiOscKey(channel, note);
+		if (oscMap.count(key) == 1)
 		{
-			oscObject = &oscMap[note];
+			oscObject = &oscMap[key];
 		}
 		else
 		{
@@ -416,6 +517,20 @@ public:
 		updateMode();
 	}
 
+	void setChannel(const int _channel)
+	{
+		channel = _channel;
+		channelSelector.setSelectedId(channel + 1, dontSendNotification);
+		setMidi(note);
+
+		if (onChannelChanged) onChannelChanged(channel);
+	}
+
+	int getChannel() const
+	{
+		return channel;
+	}
+
 	// TEXT EDITOR LISTENER
 	void textEditorReturnKeyPressed(TextEditor& e) override
 	{
@@ -443,7 +558,12 @@ public:
 				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
 				e.setText(text, dontSendNotification);
 			}
-			oscObject->setPath(text);
+			const ScopedLock sl(mapLock);
+			if (!oscObject->setPath(text))
+			{
+				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+				e.setText(oscObject->path, dontSendNotification);
+			}
 		}
 	}
 
@@ -452,11 +572,18 @@ public:
 
 	std::function<OscObject* ()> addOscObjectCallback;
 	std::function<void()> removeOscObjectCallback;
+	std::function<void(const int)> onChannelChanged;
+	DestinationsButton destinationsButton;
 
 private:
 
 	MidiOscMap& oscMap;
+	CriticalSection& mapLock;
 	OscObject* oscObject{ nullptr };
+	int channel{ 0 }; // 0 = any channel
+	int note{ 60 };
+	ComboBox channelSelector;
+	ComboBox quantiseSelector;
 	Label pathLabel;
 	TextEditor pathTextEditor;
 	AddOrRemoveButton removeButton;
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+	OscPacketPool.h
+	Created: 17 Oct 2026 3:41:36pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "OscEncoding.h"
+
+//==============================================================================
+/*
+	Fixed pool of encoded packets shared between the dispatch thread and the
+	destinations, so a message sent to several destinations is only encoded
+	and copied once. Slots are reference counted, only the dispatch thread
+	acquires them and whoever drops the last reference frees them.
+*/
+class OscPacketPool
+{
+public:
+
+	static constexpr int maxPacketSize = OscEncoding::maxPacketSize;
+
+	OscPacketPool(const int _numSlots)
+		: numSlots(_numSlots)
+		, slots(new Slot[(size_t)_numSlots])
+	{}
+
+	// DISPATCH THREAD, returns -1 if the pool is full or the packet too big
+	int acquire(const char* data, const int size, const int64 eventTicks = 0, const uint64 timeTag = OscEncoding::immediately, const int64 releaseTicks = 0)
+	{
+		if (size > maxPacketSize) return -1;
+
+		for (int i = 0; i < numSlots; ++i)
+		{
+			const int index = (cursor + i) % numSlots;
+			Slot& slot = slots[index];
+
+			if (slot.refCount.load(std::memory_order_acquire) == 0)
+			{
+				std::memcpy(slot.data, data, (size_t)size);
+				slot.size = size;
+				slot.eventTicks = eventTicks;
+				slot.encodedTicks = Time::getHighResolutionTicks();
+				slot.timeTag = timeTag;
+				slot.releaseTicks = releaseTicks;
+				slot.refCount.store(1, std::memory_order_release);
+				cursor = index + 1;
+				return index;
+			}
+		}
+
+		return -1;
+	}
+
+	void addRef(const int index)
+	{
+		slots[index].refCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void release(const int index)
+	{
+		slots[index].refCount.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	const char* getData(const int index) const
+	{
+		return slots[index].data;
+	}
+
+	int getSize(const int index) const
+	{
+		return slots[index].size;
+	}
+
+	// for the latency histograms, 0 if the packet wasn't stamped
+	int64 getEventTicks(const int index) const
+	{
+		return slots[index].eventTicks;
+	}
+
+	int64 getEncodedTicks(const int index) const
+	{
+		return slots[index].encodedTicks;
+	}
+
+	uint64 getTimeTag(const int index) const
+	{
+		return slots[index].timeTag;
+	}
+
+	// when the packet should leave before any destination offset, 0 for as soon as possible
+	int64 getReleaseTicks(const int index) const
+	{
+		return slots[index].releaseTicks;
+	}
+
+private:
+	struct Slot
+	{
+		std::atomic<int> refCount{ 0 };
+		int size{ 0 };
+		int64 eventTicks{ 0 };
+		int64 encodedTicks{ 0 };
+		uint64 timeTag{ OscEncoding::immediately };
+		int64 releaseTicks{ 0 };
+		char data[maxPacketSize];
+	};
+
+	const int numSlots;
+	std::unique_ptr<Slot[]> slots;
+	int cursor{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE(OscPacketPool)
+};
+
+//==============================================================================
+/*
+	Plain bounded single producer / single consumer queue.
+*/
+template <typename Type>
+class OscSpscQueue
+{
+public:
+
+	void prepare(const int capacity)
+	{
+		const int size = jmax(2, nextPowerOfTwo(capacity));
+		items.assign((size_t)size, Type());
+		mask = (uint32)size - 1;
+		readPos.store(0);
+		writePos.store(0);
+	}
+
+	bool push(const Type& item)
+	{
+		const uint32 w = writePos.load(std::memory_order_relaxed);
+		if (w - readPos.load(std::memory_order_acquire) > mask) return false;
+
+		items[w & mask] = item;
+		writePos.store(w + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(Type& item)
+	{
+		const uint32 r = readPos.load(std::memory_order_relaxed);
+		if (r == writePos.load(std::memory_order_acquire)) return false;
+
+		item = items[r & mask];
+		readPos.store(r + 1, std::memory_order_release);
+		return true;
+	}
+
+	int getNumReady() const
+	{
+		return (int)(writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_acquire));
+	}
+
+private:
+	std::vector<Type> items;
+	uint32 mask{ 0 };
+	std::atomic<uint32> readPos{ 0 };
+	std::atomic<uint32> writePos{ 0 };
+};
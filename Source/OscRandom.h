@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+	OscRandom.h
+	Created: 17 Oct 2026 10:52:36pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+	xoshiro128+ (Blackman & Vigna), small and fast enough that every mapping
+	can own one, so nothing is shared between threads. The same seed always
+	gives the same numbers.
+*/
+class OscRandom
+{
+public:
+
+	OscRandom()
+	{
+		setSeed(makeSeed());
+	}
+
+	explicit OscRandom(const uint64 seed)
+	{
+		setSeed(seed);
+	}
+
+	// the state is filled with splitmix64 so that small seeds still start well mixed
+	void setSeed(uint64 seed)
+	{
+		for (int i = 0; i < 4; i += 2)
+		{
+			const uint64 v = splitMix(seed);
+			state[i] = (uint32)v;
+			state[i + 1] = (uint32)(v >> 32);
+		}
+	}
+
+	uint32 nextUInt32()
+	{
+		const uint32 result = state[0] + state[3];
+		const uint32 t = state[1] << 9;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotateLeft(state[3], 11);
+
+		return result;
+	}
+
+	// 0 to 1, not including 1, from the top 24 bits which are the best mixed
+	float nextFloat()
+	{
+		return (float)(nextUInt32() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	void fill(float* dest, const int num)
+	{
+		for (int i = 0; i < num; ++i)
+			dest[i] = nextFloat();
+	}
+
+	// a different seed for every call, for mappings without a fixed one
+	static uint64 makeSeed()
+	{
+		static std::atomic<uint64> counter{ 0 };
+		uint64 seed = (uint64)Time::getHighResolutionTicks() + counter.fetch_add(0x9e3779b97f4a7c15ull);
+		return splitMix(seed);
+	}
+
+private:
+	static uint32 rotateLeft(const uint32 x, const int k)
+	{
+		return (x << k) | (x >> (32 - k));
+	}
+
+	static uint64 splitMix(uint64& x)
+	{
+		uint64 z = (x += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	uint32 state[4];
+};
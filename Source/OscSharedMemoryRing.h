@@ -0,0 +1,336 @@
+/*
+  ==============================================================================
+
+	OscSharedMemoryRing.h
+	Created: 17 Oct 2026 5:40:18pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// no JUCE in here, local consumers can copy this one header to read the ring
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+ #include <fcntl.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <unistd.h>
+ #define OSCVST_HAS_SHARED_MEMORY 1
+#else
+ #define OSCVST_HAS_SHARED_MEMORY 0
+#endif
+
+//==============================================================================
+/*
+	Encoded OSC packets in a named POSIX shared memory ring. There is one
+	writer (Oscvst) that never waits for anyone, and any number of readers.
+	Every record is a 4 byte native endian size followed by the packet padded
+	to 4 bytes. Readers that fall more than a whole ring behind skip ahead to
+	the newest packet and count an overrun. The writer publishes where it is
+	and the main reader publishes where it is, so the writer can report lag.
+*/
+namespace OscSharedMemoryRing
+{
+	constexpr uint32_t version = 1;
+	constexpr uint32_t wrapMarker = 0xffffffff;
+	constexpr uint32_t defaultCapacity = 1 << 20;
+
+	struct alignas(64) Header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t capacity; // bytes of ring after the header
+
+		alignas(64) std::atomic<uint64_t> writeReserve; // the writer may be overwriting up to here
+		std::atomic<uint64_t> writePos; // everything before this is complete
+
+		alignas(64) std::atomic<uint64_t> readPos; // published by the main reader
+		std::atomic<uint64_t> numOverruns; // counted by all readers
+	};
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "the ring needs lock free 64 bit atomics");
+
+	inline uint32_t getRecordSize(const uint32_t size)
+	{
+		return 4 + ((size + 3) & ~3u);
+	}
+
+	inline size_t getMappedSize(const uint32_t capacity)
+	{
+		return sizeof(Header) + capacity;
+	}
+
+   #if OSCVST_HAS_SHARED_MEMORY
+	//==============================================================================
+	class Mapping
+	{
+	public:
+
+		~Mapping()
+		{
+			close();
+		}
+
+		bool open(const std::string& name, const uint32_t capacity, const bool create)
+		{
+			close();
+
+			// only the same user may read or write, nothing calls shm_unlink so the segment
+			// stays (with its last packets) until it's removed by hand or the computer restarts
+			const int fd = shm_open(name.c_str(), create ? (O_CREAT | O_RDWR) : O_RDWR, 0600);
+			if (fd < 0) return false;
+
+			// one left over from an older version may still be open to everyone
+			if (create && fchmod(fd, 0600) != 0)
+			{
+				::close(fd);
+				return false;
+			}
+
+			uint32_t size = capacity;
+			if (!create)
+			{
+				// the writer decides the size
+				struct stat info;
+				if (fstat(fd, &info) != 0 || (size_t)info.st_size <= sizeof(Header))
+				{
+					::close(fd);
+					return false;
+				}
+				size = (uint32_t)((size_t)info.st_size - sizeof(Header));
+			}
+			else if (ftruncate(fd, (off_t)getMappedSize(size)) != 0)
+			{
+				::close(fd);
+				return false;
+			}
+
+			void* memory = mmap(nullptr, getMappedSize(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (memory == MAP_FAILED) return false;
+
+			mapped = memory;
+			mappedSize = getMappedSize(size);
+			return true;
+		}
+
+		void close()
+		{
+			if (mapped != nullptr) munmap(mapped, mappedSize);
+			mapped = nullptr;
+			mappedSize = 0;
+		}
+
+		Header* getHeader() const
+		{
+			return (Header*)mapped;
+		}
+
+		char* getRing() const
+		{
+			return (char*)mapped + sizeof(Header);
+		}
+
+	private:
+		void* mapped{ nullptr };
+		size_t mappedSize{ 0 };
+	};
+
+	//==============================================================================
+	class Writer
+	{
+	public:
+
+		bool open(const std::string& name, const uint32_t capacity = defaultCapacity)
+		{
+			const uint32_t size = (capacity + 3) & ~3u;
+			if (!mapping.open(name, size, true)) return false;
+
+			header = mapping.getHeader();
+			ring = mapping.getRing();
+
+			// keep the positions of a ring someone is already reading
+			if (std::memcmp(header->magic, "OSCVRNG", 8) != 0 || header->version != version || header->capacity != size)
+			{
+				header->capacity = size;
+				header->version = version;
+				header->writeReserve.store(0);
+				header->writePos.store(0);
+				header->readPos.store(0);
+				header->numOverruns.store(0);
+				std::memcpy(header->magic, "OSCVRNG", 8);
+			}
+			return true;
+		}
+
+		void close()
+		{
+			mapping.close();
+			header = nullptr;
+			ring = nullptr;
+		}
+
+		bool isOpen() const
+		{
+			return header != nullptr;
+		}
+
+		bool write(const char* data, const uint32_t size)
+		{
+			const uint32_t capacity = header->capacity;
+			const uint32_t recordSize = getRecordSize(size);
+			if (recordSize > capacity / 2) return false;
+
+			uint64_t pos = header->writePos.load(std::memory_order_relaxed);
+			uint32_t index = (uint32_t)(pos % capacity);
+
+			// records never wrap, the rest of the ring is skipped instead
+			const bool wraps = index + recordSize > capacity;
+			const uint64_t end = pos + (wraps ? capacity - index : 0) + recordSize;
+
+			header->writeReserve.store(end, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			if (wraps)
+			{
+				std::memcpy(ring + index, &wrapMarker, 4);
+				pos += capacity - index;
+				index = 0;
+			}
+
+			std::memcpy(ring + index, &size, 4);
+			std::memcpy(ring + index + 4, data, size);
+
+			header->writePos.store(end, std::memory_order_release);
+			return true;
+		}
+
+		// how many bytes the main reader is behind
+		uint64_t getReaderLag() const
+		{
+			const uint64_t w = header->writePos.load(std::memory_order_relaxed);
+			const uint64_t r = header->readPos.load(std::memory_order_relaxed);
+			return w > r ? w - r : 0;
+		}
+
+		uint64_t getNumOverruns() const
+		{
+			return header->numOverruns.load(std::memory_order_relaxed);
+		}
+
+	private:
+		Mapping mapping;
+		Header* header{ nullptr };
+		char* ring{ nullptr };
+	};
+
+	//==============================================================================
+	class Reader
+	{
+	public:
+
+		// only the main reader publishes its position for lag reporting
+		bool open(const std::string& name, const bool isMainReader = true)
+		{
+			if (!mapping.open(name, 0, false)) return false;
+
+			header = mapping.getHeader();
+			ring = mapping.getRing();
+			if (std::memcmp(header->magic, "OSCVRNG", 8) != 0 || header->version != version)
+			{
+				close();
+				return false;
+			}
+
+			mainReader = isMainReader;
+			pos = header->writePos.load(std::memory_order_acquire); // only new packets
+			publish();
+			return true;
+		}
+
+		void close()
+		{
+			mapping.close();
+			header = nullptr;
+			ring = nullptr;
+		}
+
+		// returns the packet size, 0 if there is nothing new, packets bigger than maxSize are skipped
+		uint32_t read(char* dest, const uint32_t maxSize)
+		{
+			if (header == nullptr) return 0;
+			const uint32_t capacity = header->capacity;
+
+			for (;;)
+			{
+				const uint64_t w = header->writePos.load(std::memory_order_acquire);
+				if (pos == w) return 0;
+				if (w - pos > capacity)
+				{
+					overrun(w);
+					continue;
+				}
+
+				const uint32_t index = (uint32_t)(pos % capacity);
+				uint32_t size;
+				std::memcpy(&size, ring + index, 4);
+
+				if (size == wrapMarker)
+				{
+					pos += capacity - index;
+					continue;
+				}
+
+				const bool fits = size <= maxSize && index + 4 + size <= capacity;
+				if (fits) std::memcpy(dest, ring + index + 4, size);
+
+				// the writer may have lapped us while we were copying
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (header->writeReserve.load(std::memory_order_relaxed) - pos > capacity)
+				{
+					overrun(header->writePos.load(std::memory_order_acquire));
+					continue;
+				}
+
+				pos += getRecordSize(size);
+				publish();
+
+				if (fits) return size;
+			}
+		}
+
+		uint64_t getNumOverruns() const
+		{
+			return numOverruns;
+		}
+
+	private:
+		void overrun(const uint64_t newest)
+		{
+			pos = newest;
+			++numOverruns;
+			header->numOverruns.fetch_add(1, std::memory_order_relaxed);
+			publish();
+		}
+
+		void publish()
+		{
+			if (mainReader) header->readPos.store(pos, std::memory_order_relaxed);
+		}
+
+		Mapping mapping;
+		Header* header{ nullptr };
+		char* ring{ nullptr };
+		uint64_t pos{ 0 };
+		uint64_t numOverruns{ 0 };
+		bool mainReader{ true };
+	};
+   #endif
+}
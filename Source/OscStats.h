@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+	OscStats.h
+	Created: 17 Oct 2026 8:31:16pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "OscEncoding.h"
+
+//==============================================================================
+// counters kept by the processor, the per destination ones live in OscTransportCounters
+struct OscStats
+{
+	std::atomic<uint64> eventsReceived{ 0 }; // audio thread and the on screen keyboard
+	std::atomic<uint64> messagesEncoded{ 0 }; // dispatch thread
+	std::atomic<uint32> poolDrops{ 0 }; // dispatch thread, packet pool was full
+	std::atomic<uint32> queueHighWater{ 0 }; // dispatch thread, most events waiting at once
+
+	void updateHighWater(const int numReady)
+	{
+		if ((uint32)numReady > queueHighWater.load(std::memory_order_relaxed))
+			queueHighWater.store((uint32)numReady, std::memory_order_relaxed);
+	}
+};
+
+//==============================================================================
+/*
+	Publishes the counters as one int64 message per counter under a base path,
+	i.e /oscvst/stats/events. The messages are compiled when the path changes,
+	publishing only patches the values in.
+*/
+class OscStatsPublisher
+{
+public:
+
+	enum Counter
+	{
+		Events,
+		Messages,
+		Datagrams,
+		Bytes,
+		Bundles,
+		QueueDrops,
+		PoolDrops,
+		DestinationDrops,
+		TransportDrops,
+		QueueHighWater,
+		SendErrors,
+		Reconnects,
+		ShmLag,
+		ShmOverruns,
+		DatagramsPerSyscall,
+		numCounters
+	};
+
+	OscStatsPublisher()
+	{
+		setPath("/oscvst/stats");
+	}
+
+	bool setPath(const String& _path)
+	{
+		const String newPath = (_path.startsWith("/") ? _path : String("/") + _path).trimCharactersAtEnd("/");
+		if (!OscEncoding::isValidAddress(newPath + "/events")) return false;
+
+		path = newPath;
+
+		static const char* const names[numCounters] = {
+			"events", "messages", "datagrams", "bytes", "bundles",
+			"drops/queue", "drops/pool", "drops/destination", "drops/transport",
+			"queue_high_water", "send_errors", "reconnects",
+			"shm/lag", "shm/overruns", "datagrams_per_syscall"
+		};
+
+		for (int i = 0; i < numCounters; ++i)
+		{
+			const String address = path + "/" + names[i];
+			const auto addressSize = (int)address.getNumBytesAsUTF8();
+			const int typeTagsOffset = OscEncoding::getPaddedSize(addressSize);
+			const int argOffset = typeTagsOffset + OscEncoding::getPaddedSize(2);
+
+			// int64 counts, so nothing wraps while the plugin is loaded
+			const bool isRatio = i == DatagramsPerSyscall;
+			const char typeTags[] = { ',', isRatio ? 'f' : 'h', 0 };
+
+			auto& message = messages[(size_t)i];
+			message.assign((size_t)(argOffset + (isRatio ? 4 : 8)), 0);
+			OscEncoding::writeString(message.data(), address.toRawUTF8(), addressSize);
+			OscEncoding::writeString(message.data() + typeTagsOffset, typeTags, 2);
+		}
+		return true;
+	}
+
+	const String& getPath() const
+	{
+		return path;
+	}
+
+	const char* render(const Counter counter, const uint64 value)
+	{
+		auto& message = messages[(size_t)counter];
+		OscEncoding::writeUInt64(message.data() + message.size() - 8, value);
+		return message.data();
+	}
+
+	// the one float, how well the sends are being batched
+	const char* renderRatio(const Counter counter, const float value)
+	{
+		auto& message = messages[(size_t)counter];
+		OscEncoding::writeFloat32(message.data() + message.size() - 4, value);
+		return message.data();
+	}
+
+	int getEncodedSize(const Counter counter) const
+	{
+		return (int)messages[(size_t)counter].size();
+	}
+
+private:
+	String path;
+	std::array<std::vector<char>, numCounters> messages;
+};
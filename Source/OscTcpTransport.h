@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+	OscTcpTransport.h
+	Created: 17 Oct 2026 5:02:31pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "OscEncoding.h"
+#include "OscTransport.h"
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <sys/socket.h>
+ #include <cerrno>
+#endif
+
+//==============================================================================
+/*
+	OSC 1.1 over TCP with SLIP framing. The connection is kept open, queued
+	packets are framed into one output buffer and written in large chunks
+	without blocking. If the connection drops it is retried with backoff, all
+	of it on the sender thread, and frames that weren't fully written are kept
+	until the next connection.
+*/
+class OscTcpTransport : public OscTransport
+{
+public:
+
+	OscTcpTransport(OscTransportCounters& _counters)
+		: OscTransport(_counters)
+	{
+		output.reserve(maxWriteSize);
+	}
+
+	// only remembers the target, the connection is made by submit()
+	bool connect(const String& address, const int port) override
+	{
+		disconnect();
+
+		targetAddress = address;
+		targetPort = port;
+		backoffMs = minBackoffMs;
+		nextAttemptMs = 0.0;
+		return true;
+	}
+
+	void disconnect() override
+	{
+		clearQueue();
+		socket.reset();
+		output.clear();
+		numWritten = 0;
+	}
+
+	bool isConnected() const override
+	{
+		return socket != nullptr && socket->isConnected();
+	}
+
+	int submit() override
+	{
+		const int numPackets = (int)packets.size();
+
+		for (const auto& packet : packets)
+		{
+			if ((int)output.size() + packet.size * 2 + 2 > maxPendingBytes)
+			{
+				// nobody has been listening for a while, newest frames go first
+				counters.numDropped.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+			OscEncoding::appendSlipFrame(output, arena.data() + packet.offset, packet.size);
+			++numPendingFrames;
+		}
+		clearQueue();
+
+		if (!isConnected()) tryConnect();
+		if (isConnected()) writePending();
+
+		return numPackets;
+	}
+
+	int getMsUntilNextSubmit() const override
+	{
+		if (!isConnected())
+			return targetPort > 0 ? jmax(1, (int)(nextAttemptMs - Time::getMillisecondCounterHiRes())) : -1;
+
+		return output.size() > numWritten ? retryWriteMs : -1;
+	}
+
+private:
+	static constexpr int maxWriteSize = 64 * 1024;
+	static constexpr int maxPendingBytes = 1024 * 1024;
+	static constexpr int connectTimeoutMs = 200;
+	static constexpr int minBackoffMs = 250;
+	static constexpr int maxBackoffMs = 8000;
+	static constexpr int retryWriteMs = 2;
+
+	void tryConnect()
+	{
+		const double now = Time::getMillisecondCounterHiRes();
+		if (targetPort <= 0 || now < nextAttemptMs) return;
+
+		socket = std::make_unique<StreamingSocket>();
+		if (socket->connect(targetAddress, targetPort, connectTimeoutMs))
+		{
+			counters.numReconnects.fetch_add(1, std::memory_order_relaxed);
+			backoffMs = minBackoffMs;
+			return;
+		}
+
+		socket.reset();
+		nextAttemptMs = now + backoffMs;
+		backoffMs = jmin(backoffMs * 2, maxBackoffMs);
+	}
+
+	void writePending()
+	{
+		while (output.size() > numWritten)
+		{
+			const int size = (int)jmin(output.size() - numWritten, (size_t)maxWriteSize);
+			const int result = write(output.data() + numWritten, size);
+
+			if (result < 0)
+			{
+				connectionLost();
+				return;
+			}
+			if (result == 0) break; // the socket is full, try again soon
+
+			counters.count(0, result);
+			numWritten += (size_t)result;
+		}
+
+		if (numWritten == output.size())
+		{
+			counters.numDatagrams.fetch_add((uint64)numPendingFrames, std::memory_order_relaxed);
+			numPendingFrames = 0;
+			output.clear();
+			numWritten = 0;
+		}
+	}
+
+	// returns the number of bytes written, 0 if it would block, -1 if the connection is gone
+	int write(const char* data, const int size)
+	{
+	   #if JUCE_LINUX || JUCE_MAC
+		int flags = MSG_DONTWAIT;
+	   #ifdef MSG_NOSIGNAL
+		flags |= MSG_NOSIGNAL;
+	   #endif
+		const auto result = ::send(socket->getRawSocketHandle(), data, (size_t)size, flags);
+		if (result >= 0) return (int)result;
+		return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+	   #else
+		// no portable non blocking send, only write once the socket says it has room
+		const int ready = socket->waitUntilReady(false, 0);
+		if (ready < 0) return -1;
+		if (ready == 0) return 0;
+		return socket->write(data, jmin(size, 4096));
+	   #endif
+	}
+
+	void connectionLost()
+	{
+		counters.numSendErrors.fetch_add(1, std::memory_order_relaxed);
+		socket.reset();
+
+		// go back to the start of the frame that was cut off, SLIP frames
+		// always start with an END byte and END never appears inside one
+		size_t frameStart = numWritten;
+		while (frameStart > 0 && output[frameStart - 1] != OscEncoding::slipEnd)
+			--frameStart;
+		if (frameStart > 0 && frameStart < output.size()) --frameStart;
+
+		output.erase(output.begin(), output.begin() + (std::ptrdiff_t)frameStart);
+		numWritten = 0;
+
+		nextAttemptMs = Time::getMillisecondCounterHiRes() + backoffMs;
+		backoffMs = jmin(backoffMs * 2, maxBackoffMs);
+	}
+
+	std::unique_ptr<StreamingSocket> socket;
+	String targetAddress;
+	int targetPort{ 0 };
+
+	std::vector<char> output; // slip framed, not yet written
+	size_t numWritten{ 0 };
+	int numPendingFrames{ 0 };
+
+	int backoffMs{ minBackoffMs };
+	double nextAttemptMs{ 0.0 };
+
+	JUCE_DECLARE_NON_COPYABLE(OscTcpTransport)
+};
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+	OscTimeTag.h
+	Created: 17 Oct 2026 11:26:03pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "OscEncoding.h"
+
+//==============================================================================
+/*
+	Turns high resolution ticks into OSC timetags (NTP, seconds since 1900 in
+	32.32 fixed point). The wall clock is only read once, after that the ticks
+	carry it, so timetags don't jump when the system clock is adjusted.
+*/
+class OscTimeTagClock
+{
+public:
+
+	OscTimeTagClock()
+	{
+		calibrate();
+	}
+
+	void calibrate()
+	{
+		baseTicks = Time::getHighResolutionTicks();
+		const auto unixMs = (uint64)Time::currentTimeMillis();
+		baseTimeTag = ((unixMs / 1000 + secondsFrom1900To1970) << 32) + (((unixMs % 1000) << 32) / 1000);
+	}
+
+	uint64 toTimeTag(const int64 ticks) const
+	{
+		const double seconds = Time::highResolutionTicksToSeconds(ticks - baseTicks);
+		return baseTimeTag + (uint64)(int64)(seconds * 4294967296.0);
+	}
+
+private:
+	static constexpr uint64 secondsFrom1900To1970 = 2208988800ull;
+
+	int64 baseTicks{ 0 };
+	uint64 baseTimeTag{ OscEncoding::immediately };
+};
+
+//==============================================================================
+/*
+	When each audio block starts, in ticks. processBlock is called with some
+	jitter, but the audio itself is continuous, so the start of a block is
+	predicted from the last one and only nudged towards the measured time.
+	After a dropout, a reset or a big jump it snaps back to the measured time.
+*/
+class OscBlockClock
+{
+public:
+
+	void prepare(const double sampleRate)
+	{
+		ticksPerSample = (double)Time::getHighResolutionTicksPerSecond() / jmax(1.0, sampleRate);
+		reset();
+	}
+
+	void reset()
+	{
+		nextBlockTicks = 0.0;
+	}
+
+	// AUDIO THREAD, call once per block
+	int64 advance(const int64 nowTicks, const int numSamples)
+	{
+		const double blockTicks = numSamples * ticksPerSample;
+		const double error = (double)nowTicks - nextBlockTicks;
+
+		if (nextBlockTicks == 0.0 || std::abs(error) > 2.0 * blockTicks)
+			nextBlockTicks = (double)nowTicks;
+		else
+			nextBlockTicks += error / 16.0; // follows drift between the audio and system clocks
+
+		blockStartTicks = (int64)nextBlockTicks;
+		nextBlockTicks += blockTicks;
+		return blockStartTicks;
+	}
+
+	int64 getTicks(const int sampleOffset) const
+	{
+		return blockStartTicks + (int64)(sampleOffset * ticksPerSample);
+	}
+
+private:
+	double ticksPerSample{ 0.0 };
+	double nextBlockTicks{ 0.0 };
+	int64 blockStartTicks{ 0 };
+};
@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+	OscTimingWheel.h
+	Created: 18 Oct 2026 12:14:37am
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+	Hierarchical timing wheel (Varghese & Lauck) holding values until a tick.
+	The first level has one slot per tick, each level above covers a whole
+	turn of the one below and is spread down into it as time reaches it.
+	Insert and expire are O(1), entries live in a fixed pool of nodes so
+	nothing is allocated after construction, and values due on the same
+	tick come out in the order they went in, however they got to the first
+	level. Only one thread may use it.
+*/
+template <typename Type>
+class OscTimingWheel
+{
+public:
+
+	OscTimingWheel(const int capacity)
+		: nodes((size_t)capacity)
+	{
+		clear(0);
+	}
+
+	// forgets everything and starts the wheel at the given tick
+	void clear(const int64 tick)
+	{
+		for (auto& level : levels)
+			for (auto& slot : level)
+				slot = {};
+		occupied.fill(0);
+		levelCounts.fill(0);
+
+		freeList = -1;
+		for (int i = (int)nodes.size(); --i >= 0;)
+		{
+			nodes[(size_t)i].next = freeList;
+			freeList = i;
+		}
+
+		currentTick = tick;
+		numPending = 0;
+	}
+
+	// false if the wheel is full, values due now or earlier come out on the next tick
+	bool insert(const int64 dueTick, const Type& value)
+	{
+		if (freeList < 0) return false;
+
+		const int index = freeList;
+		Node& node = nodes[(size_t)index];
+		freeList = node.next;
+
+		node.dueTick = jmax(dueTick, currentTick + 1);
+		node.sequence = nextSequence++;
+		node.value = value;
+		link(index);
+		++numPending;
+		return true;
+	}
+
+	// moves up to the tick, calling expire(value) for everything due by then in order
+	template <typename Callback>
+	void advance(const int64 tick, Callback&& expire)
+	{
+		// nothing waiting, skip straight there
+		if (numPending == 0)
+		{
+			currentTick = jmax(currentTick, tick);
+			return;
+		}
+
+		while (currentTick < tick && numPending > 0)
+		{
+			++currentTick;
+
+			// spread the higher levels down as the lower ones complete a turn, top first
+			int topLevel = 0;
+			while (topLevel + 1 < numLevels && (currentTick & (((int64)1 << ((topLevel + 1) * bitsPerLevel)) - 1)) == 0)
+				++topLevel;
+			for (int level = topLevel; level >= 1; --level)
+				cascade(level, getSlot(currentTick, level));
+
+			const int slot = getSlot(currentTick, 0);
+			Slot list = levels[0][(size_t)slot];
+			levels[0][(size_t)slot] = {};
+			setOccupied(slot, false);
+
+			for (int index = list.head; index >= 0;)
+			{
+				Node& node = nodes[(size_t)index];
+				const int next = node.next;
+
+				expire(node.value);
+
+				node.next = freeList;
+				freeList = index;
+				--numPending;
+				--levelCounts[0];
+				index = next;
+			}
+		}
+
+		currentTick = jmax(currentTick, tick);
+	}
+
+	// hands back everything still waiting, not in any order, and empties the wheel
+	template <typename Callback>
+	void drain(Callback&& forEach)
+	{
+		for (auto& level : levels)
+			for (auto& slot : level)
+				for (int index = slot.head; index >= 0; index = nodes[(size_t)index].next)
+					forEach(nodes[(size_t)index].value);
+
+		clear(currentTick);
+	}
+
+	// ticks until the next value is due, or until the first level turns over
+	// while the levels above hold anything, -1 if empty
+	int64 getTicksUntilNext() const
+	{
+		if (numPending == 0) return -1;
+
+		const int64 untilTurnover = slotsPerLevel - (int)(currentTick & (slotsPerLevel - 1));
+		const int64 limit = numPending > levelCounts[0] ? untilTurnover : slotsPerLevel;
+
+		const int start = getSlot(currentTick + 1, 0);
+		for (int word = 0; word <= numWords; ++word)
+		{
+			const int w = (start / 64 + word) % numWords;
+			uint64 bits = occupied[(size_t)w];
+			if (word == 0) bits &= ~(uint64)0 << (start % 64);
+			else if (word == numWords) bits &= ((uint64)1 << (start % 64)) - 1;
+
+			if (bits != 0)
+			{
+				const int slot = w * 64 + countTrailingZeros(bits);
+				return jmin(limit, (int64)(1 + ((slot - start) & (slotsPerLevel - 1))));
+			}
+		}
+
+		// only higher levels have anything
+		return untilTurnover;
+	}
+
+	int getNumPending() const
+	{
+		return numPending;
+	}
+
+private:
+	static constexpr int bitsPerLevel = 8;
+	static constexpr int slotsPerLevel = 1 << bitsPerLevel;
+	static constexpr int numLevels = 4; // 2^32 ticks, 49 days of milliseconds
+	static constexpr int numWords = slotsPerLevel / 64;
+
+	struct Node
+	{
+		int64 dueTick{ 0 };
+		uint64 sequence{ 0 }; // insertion order, kept when cascading
+		int next{ -1 };
+		Type value{};
+	};
+
+	struct Slot
+	{
+		int head{ -1 };
+		int tail{ -1 };
+	};
+
+	static int getSlot(const int64 tick, const int level)
+	{
+		return (int)((tick >> (level * bitsPerLevel)) & (slotsPerLevel - 1));
+	}
+
+	static int countTrailingZeros(uint64 bits)
+	{
+		int n = 0;
+		while ((bits & 1) == 0)
+		{
+			bits >>= 1;
+			++n;
+		}
+		return n;
+	}
+
+	void setOccupied(const int slot, const bool isOccupied)
+	{
+		const uint64 bit = (uint64)1 << (slot % 64);
+		if (isOccupied) occupied[(size_t)(slot / 64)] |= bit;
+		else occupied[(size_t)(slot / 64)] &= ~bit;
+	}
+
+	// the lowest level whose turn still contains the due tick
+	void link(const int index)
+	{
+		Node& node = nodes[(size_t)index];
+		const int64 delta = node.dueTick - currentTick;
+
+		int level = 0;
+		while (level < numLevels - 1 && delta >= ((int64)1 << ((level + 1) * bitsPerLevel)))
+			++level;
+
+		// further out than the top level reaches, park it in the last top slot
+		const int64 dueTick = level == numLevels - 1 && delta >= ((int64)1 << (numLevels * bitsPerLevel))
+			? currentTick + ((int64)1 << (numLevels * bitsPerLevel)) - 1
+			: node.dueTick;
+
+		const int slot = getSlot(dueTick, level);
+		Slot& list = levels[(size_t)level][(size_t)slot];
+
+		// new entries are the newest and go on the end, cascaded ones may be older
+		if (list.tail < 0 || nodes[(size_t)list.tail].sequence < node.sequence)
+		{
+			node.next = -1;
+			if (list.tail >= 0) nodes[(size_t)list.tail].next = index;
+			else list.head = index;
+			list.tail = index;
+		}
+		else
+		{
+			int* position = &list.head;
+			while (nodes[(size_t)*position].sequence < node.sequence)
+				position = &nodes[(size_t)*position].next;
+			node.next = *position;
+			*position = index;
+		}
+
+		++levelCounts[(size_t)level];
+		if (level == 0) setOccupied(slot, true);
+	}
+
+	void cascade(const int level, const int slot)
+	{
+		Slot list = levels[(size_t)level][(size_t)slot];
+		levels[(size_t)level][(size_t)slot] = {};
+
+		for (int index = list.head; index >= 0;)
+		{
+			const int next = nodes[(size_t)index].next;
+			--levelCounts[(size_t)level];
+			link(index);
+			index = next;
+		}
+	}
+
+	std::vector<Node> nodes;
+	std::array<std::array<Slot, slotsPerLevel>, numLevels> levels;
+	std::array<uint64, numWords> occupied; // first level slots with something in them
+	std::array<int, numLevels> levelCounts; // entries waiting on each level
+	uint64 nextSequence{ 0 };
+	int freeList{ -1 };
+	int64 currentTick{ 0 };
+	int numPending{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE(OscTimingWheel)
+};
@@ -0,0 +1,322 @@
+/*
+  ==============================================================================
+
+	OscTransport.h
+	Created: 17 Oct 2026 12:44:52pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+#include <JuceHeader.h>
+
+#if JUCE_LINUX
+ #include <sys/socket.h>
+ #include <netdb.h>
+ #include <cerrno>
+#endif
+
+// OscMulticast.cpp
+bool oscvstSetMulticastOptions(const int handle, const int ttl, const char* interfaceAddress, const bool loopback);
+
+//==============================================================================
+struct OscMulticastOptions
+{
+	int ttl = 1; // 1 = stay on the local network
+	String interfaceAddress; // empty = let the system pick
+	bool loopback = true; // receivers on this machine get it too
+
+	// 224.0.0.0 - 239.255.255.255
+	static bool isMulticastAddress(const String& address)
+	{
+		if (!address.containsOnly("0123456789.") || address.indexOfChar('.') < 0) return false;
+
+		const int firstOctet = address.upToFirstOccurrenceOf(".", false, false).getIntValue();
+		return firstOctet >= 224 && firstOctet <= 239;
+	}
+};
+
+//==============================================================================
+// owned by the destination so they survive switching transports
+struct OscTransportCounters
+{
+	std::atomic<uint64> numSyscalls{ 0 };
+	std::atomic<uint64> numDatagrams{ 0 }; // packets for udp, frames for tcp
+	std::atomic<uint64> numBytes{ 0 };
+	std::atomic<uint64> numBundles{ 0 };
+	std::atomic<uint32> numDropped{ 0 }; // no room for them, i.e a full tcp buffer
+	std::atomic<uint32> numSendErrors{ 0 }; // the socket refused them or the connection dropped
+	std::atomic<uint32> numReconnects{ 0 };
+	std::atomic<uint64> readerLag{ 0 }; // shared memory only, bytes the reader is behind
+	std::atomic<uint64> numOverruns{ 0 }; // shared memory only, times a reader was lapped
+
+	void count(const int datagrams, const int bytes)
+	{
+		numSyscalls.fetch_add(1, std::memory_order_relaxed);
+		numDatagrams.fetch_add((uint64)datagrams, std::memory_order_relaxed);
+		numBytes.fetch_add((uint64)bytes, std::memory_order_relaxed);
+	}
+
+	float getDatagramsPerSyscall() const
+	{
+		const auto syscalls = numSyscalls.load(std::memory_order_relaxed);
+		return syscalls > 0 ? (float)numDatagrams.load(std::memory_order_relaxed) / (float)syscalls : 0.0f;
+	}
+
+	void reset()
+	{
+		numSyscalls.store(0, std::memory_order_relaxed);
+		numDatagrams.store(0, std::memory_order_relaxed);
+		numBytes.store(0, std::memory_order_relaxed);
+		numBundles.store(0, std::memory_order_relaxed);
+		numDropped.store(0, std::memory_order_relaxed);
+		numSendErrors.store(0, std::memory_order_relaxed);
+		numReconnects.store(0, std::memory_order_relaxed);
+		readerLag.store(0, std::memory_order_relaxed);
+		numOverruns.store(0, std::memory_order_relaxed);
+	}
+};
+
+//==============================================================================
+/*
+	Sends already encoded OSC packets. Packets are queued during a flush and
+	then submitted together. Only the destination's sender thread uses it.
+*/
+class OscTransport
+{
+public:
+
+	OscTransport(OscTransportCounters& _counters)
+		: counters(_counters)
+	{}
+
+	virtual ~OscTransport() = default;
+
+	virtual bool connect(const String& address, const int port) = 0;
+	virtual void disconnect() = 0;
+
+	// only used by udp, before connect()
+	virtual void setMulticastOptions(const OscMulticastOptions&) {}
+	virtual bool isConnected() const = 0;
+
+	// sends everything queued since the last submit, returns the number of packets sent
+	virtual int submit() = 0;
+
+	// how long until submit() wants to run again even without new packets, or -1
+	virtual int getMsUntilNextSubmit() const
+	{
+		return -1;
+	}
+
+	OscTransportCounters& getCounters()
+	{
+		return counters;
+	}
+
+	// copies the packet, nothing is sent until submit()
+	void queue(const void* data, const int size)
+	{
+		const size_t offset = arena.size();
+		arena.insert(arena.end(), (const char*)data, (const char*)data + size);
+		packets.push_back({ offset, size });
+	}
+
+protected:
+	struct QueuedPacket
+	{
+		size_t offset;
+		int size;
+	};
+
+	void clearQueue()
+	{
+		arena.clear();
+		packets.clear();
+	}
+
+	OscTransportCounters& counters;
+	std::vector<char> arena;
+	std::vector<QueuedPacket> packets;
+
+	JUCE_DECLARE_NON_COPYABLE(OscTransport)
+};
+
+//==============================================================================
+/*
+	UDP, on Linux a whole flush goes out in one sendmmsg call, elsewhere it
+	falls back to one write per packet. Multicast group addresses get the
+	ttl, interface and loopback options applied when connecting.
+*/
+class OscUdpTransport : public OscTransport
+{
+public:
+
+	OscUdpTransport(OscTransportCounters& _counters)
+		: OscTransport(_counters)
+	{}
+
+	void setMulticastOptions(const OscMulticastOptions& options) override
+	{
+		multicast = options;
+	}
+
+	bool connect(const String& address, const int port) override
+	{
+		disconnect();
+
+		socket = std::make_unique<DatagramSocket>(false);
+		if (!socket->bindToPort(0))
+		{
+			socket.reset();
+			return false;
+		}
+
+		targetAddress = address;
+		targetPort = port;
+
+		// one datagram reaches every receiver in the group
+		if (OscMulticastOptions::isMulticastAddress(address))
+		{
+			oscvstSetMulticastOptions(socket->getRawSocketHandle(), multicast.ttl
+				, multicast.interfaceAddress.toRawUTF8(), multicast.loopback);
+		}
+
+	   #if JUCE_LINUX
+		resolveTarget();
+	   #endif
+
+		return true;
+	}
+
+	void disconnect() override
+	{
+		clearQueue();
+		socket.reset();
+
+	   #if JUCE_LINUX
+		targetLength = 0;
+	   #endif
+	}
+
+	bool isConnected() const override
+	{
+		return socket != nullptr;
+	}
+
+	bool send(const void* data, const int size)
+	{
+		if (!socket) return false;
+
+		counters.count(1, size);
+		return socket->write(targetAddress, targetPort, data, size) == size;
+	}
+
+	int submit() override
+	{
+		int numSent = 0;
+
+		if (socket && !packets.empty())
+		{
+		   #if JUCE_LINUX
+			numSent = submitBatched();
+		   #endif
+
+			// whatever sendmmsg didn't take goes out one by one
+			for (size_t i = (size_t)numSent; i < packets.size(); ++i)
+			{
+				if (send(arena.data() + packets[i].offset, packets[i].size)) ++numSent;
+			}
+		}
+
+		counters.numSendErrors.fetch_add((uint32)((int)packets.size() - numSent), std::memory_order_relaxed);
+		clearQueue();
+		return numSent;
+	}
+
+private:
+   #if JUCE_LINUX
+	static constexpr int maxBatch = 64;
+
+	void resolveTarget()
+	{
+		targetLength = 0;
+
+		addrinfo hints{};
+		hints.ai_family = AF_INET;
+		hints.ai_socktype = SOCK_DGRAM;
+
+		addrinfo* info = nullptr;
+		if (getaddrinfo(targetAddress.toRawUTF8(), String(targetPort).toRawUTF8(), &hints, &info) == 0 && info != nullptr)
+		{
+			std::memcpy(&target, info->ai_addr, (size_t)info->ai_addrlen);
+			targetLength = (socklen_t)info->ai_addrlen;
+		}
+
+		if (info != nullptr) freeaddrinfo(info);
+	}
+
+	int submitBatched()
+	{
+		const int handle = socket->getRawSocketHandle();
+		if (targetLength == 0 || handle < 0) return 0;
+
+		const int numPackets = (int)packets.size();
+		int numSent = 0;
+
+		while (numSent < numPackets)
+		{
+			const int count = jmin(maxBatch, numPackets - numSent);
+
+			for (int i = 0; i < count; ++i)
+			{
+				const auto& packet = packets[(size_t)(numSent + i)];
+				iovecs[i].iov_base = arena.data() + packet.offset;
+				iovecs[i].iov_len = (size_t)packet.size;
+
+				messages[i] = {};
+				messages[i].msg_hdr.msg_name = &target;
+				messages[i].msg_hdr.msg_namelen = targetLength;
+				messages[i].msg_hdr.msg_iov = &iovecs[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			const int result = sendmmsg(handle, messages, (unsigned int)count, 0);
+			if (result < 0)
+			{
+				if (errno == EINTR) continue;
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					if (socket->waitUntilReady(false, 10) == 1) continue;
+				}
+				break; // let the per packet path try the rest
+			}
+
+			int numBytes = 0;
+			for (int i = 0; i < result; ++i)
+				numBytes += (int)iovecs[i].iov_len;
+
+			counters.count(result, numBytes);
+			numSent += result;
+			if (result == 0) break;
+		}
+
+		return numSent;
+	}
+
+	sockaddr_storage target{};
+	socklen_t targetLength{ 0 };
+	mmsghdr messages[maxBatch];
+	iovec iovecs[maxBatch];
+   #endif
+
+	std::unique_ptr<DatagramSocket> socket;
+	String targetAddress;
+	int targetPort{ 0 };
+	OscMulticastOptions multicast;
+
+	JUCE_DECLARE_NON_COPYABLE(OscUdpTransport)
+};
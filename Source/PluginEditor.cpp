@@ -15,7 +15,8 @@ OscvstAudioProcessorEditor::OscvstAudioProcessorEditor(OscvstAudioProcessor& p)
 	, audioProcessor(p)
 	, oscMap(p.oscMap)
 	, keyboardComponent(audioProcessor.keyboardState, MidiKeyboardComponent::Orientation::horizontalKeyboard, oscMap)
-	, oscObjectComponent(oscMap)
+	, oscObjectComponent(oscMap, p.mapLock)
+	, controllerMenuComponent(p)
 	, settingsMenuComponent(p)
 {
 	// GUI
@@ -33,19 +34,42 @@ OscvstAudioProcessorEditor::OscvstAudioProcessorEditor(OscvstAudioProcessor& p)
 	// OSC OBJECT COMPONENT
 	oscObjectComponent.addOscObjectCallback = [this]()
 	{
-		return this->addOscObject(keyboardComponent.lastKey, "/oscvst");
+		return this->addOscObject(oscObjectComponent.getChannel(), keyboardComponent.lastKey, "/oscvst");
 	};
 	oscObjectComponent.removeOscObjectCallback = [this]()
 	{
-		this->removeOscObject(keyboardComponent.lastKey);
+		this->removeOscObject(oscObjectComponent.getChannel(), keyboardComponent.lastKey);
+	};
+	oscObjectComponent.destinationsButton.setDestinations(&audioProcessor.osc.destinations);
+	oscObjectComponent.onChannelChanged = [this](const int channel)
+	{
+		this->keyboardComponent.channel = channel;
+		this->keyboardComponent.repaint();
 	};
 	addAndMakeVisible(oscObjectComponent);
 
+	// CONTROLLER MENU COMPONENT
+	addAndMakeVisible(controllerMenuComponent);
+
 	// KNOB MENU COMPONENT
 	for (int i = 0; i < audioProcessor.knobs.size(); ++i)
 	{
 		knobs.add(new SliderParameterAttachment(*audioProcessor.paramsState.getParameter(String("knob") + String(i + 1)), *knobMenuComponent.knobs[i]));
 	}
+	knobMenuComponent.streamToggle.setToggleState(audioProcessor.osc.streamKnobs, dontSendNotification);
+	knobMenuComponent.streamToggle.onClick = [this]()
+	{
+		audioProcessor.osc.streamKnobs = knobMenuComponent.streamToggle.getToggleState();
+	};
+	knobMenuComponent.onKnobRightClicked = [this](const int knob)
+	{
+		KnobStreamMenu menu(audioProcessor, knob);
+		PopupMenu m;
+		m.setLookAndFeel(&getLookAndFeel());
+		m.addItem(1, "close");
+		m.addCustomItem(2, menu, 200, 120, false);
+		m.show();
+	};
 	addAndMakeVisible(knobMenuComponent);
 
 	// OSC
@@ -69,11 +93,18 @@ OscvstAudioProcessorEditor::OscvstAudioProcessorEditor(OscvstAudioProcessor& p)
 	{
 		this->keyboardComponent.repaint();
 		this->oscObjectComponent.setMidi(keyboardComponent.lastKey);
+		this->controllerMenuComponent.updateMode();
+		this->settingsMenuComponent.reset();
+		this->knobMenuComponent.streamToggle.setToggleState(audioProcessor.osc.streamKnobs, dontSendNotification);
 	};
+
+	// the keyboard only follows incoming MIDI at this rate
+	startTimerHz(30);
 }
 
 OscvstAudioProcessorEditor::~OscvstAudioProcessorEditor()
 {
+	stopTimer();
 	setLookAndFeel(nullptr);
 }
 
@@ -88,6 +119,7 @@ void OscvstAudioProcessorEditor::resized()
 	int y = 0;
 	menuBar.setBounds(0, 0, getWidth(), 25);
 	y += 25;
+	controllerMenuComponent.setBounds(0, y, getWidth(), getHeight() - y);
 	knobMenuComponent.setBounds(0, y, getWidth(), getHeight() - y);
 	settingsMenuComponent.setBounds(0, y, getWidth(), getHeight() - y);
 
@@ -97,9 +129,9 @@ void OscvstAudioProcessorEditor::resized()
 }
 
 //==============================================================================
-OscObject* OscvstAudioProcessorEditor::addOscObject(const int note, const String& path)
+OscObject* OscvstAudioProcessorEditor::addOscObject(const int channel, const int note, const String& path)
 {
-	if (auto oscObject = audioProcessor.addOscObject( note, path))
+	if (auto oscObject = audioProcessor.addOscObject(channel, note, path))
 	{
 		keyboardComponent.repaint();
 		return oscObject;
@@ -109,14 +141,20 @@ OscObject* OscvstAudioProcessorEditor::addOscObject(const int note, const String
 }
 
 //==============================================================================
-void OscvstAudioProcessorEditor::removeOscObject(const int note)
+void OscvstAudioProcessorEditor::removeOscObject(const int channel, const int note)
 {
-	if (audioProcessor.removeOscObject(note))
+	if (audioProcessor.removeOscObject(channel, note))
 	{
 		keyboardComponent.repaint();
 	}
 }
 
+//==============================================================================
+void OscvstAudioProcessorEditor::timerCallback()
+{
+	audioProcessor.updateKeyboardState();
+}
+
 //==============================================================================
 void OscvstAudioProcessorEditor::setScene(const Scenes _scene)
 {
@@ -129,6 +167,17 @@ void OscvstAudioProcessorEditor::setScene(const Scenes _scene)
 	{
 		oscObjectComponent.setVisible(true);
 		keyboardComponent.setVisible(true);
+		controllerMenuComponent.setVisible(false);
+		knobMenuComponent.setVisible(false);
+		settingsMenuComponent.setVisible(false);
+	}
+	break;
+
+	case Scenes::ControllerMenu:
+	{
+		oscObjectComponent.setVisible(false);
+		keyboardComponent.setVisible(false);
+		controllerMenuComponent.setVisible(true);
 		knobMenuComponent.setVisible(false);
 		settingsMenuComponent.setVisible(false);
 	}
@@ -138,6 +187,7 @@ void OscvstAudioProcessorEditor::setScene(const Scenes _scene)
 	{
 		oscObjectComponent.setVisible(false);
 		keyboardComponent.setVisible(false);
+		controllerMenuComponent.setVisible(false);
 		knobMenuComponent.setVisible(true);
 		settingsMenuComponent.setVisible(false);
 	}
@@ -147,6 +197,7 @@ void OscvstAudioProcessorEditor::setScene(const Scenes _scene)
 	{
 		oscObjectComponent.setVisible(false);
 		keyboardComponent.setVisible(false);
+		controllerMenuComponent.setVisible(false);
 		knobMenuComponent.setVisible(false);
 		settingsMenuComponent.setVisible(true);
 	}
@@ -16,11 +16,13 @@
 #include "KnobMenuComponent.h"
 #include "PatLookAndFeel.h"
 #include "SettingsMenuComponent.h"
+#include "ControllerMenuComponent.h"
 
 //==============================================================================
 static enum class Scenes
 {
 	OscEdit,
+	ControllerMenu,
 	KnobMenu,
 	SettingsMenu
 };
@@ -38,6 +40,10 @@ public:
 		oscEditButton.setButtonText("osc edit");
 		oscEditButton.addListener(this);
 
+		addAndMakeVisible(controllerMenuButton);
+		controllerMenuButton.setButtonText("cc");
+		controllerMenuButton.addListener(this);
+
 		addAndMakeVisible(knobMenuButton);
 		knobMenuButton.setButtonText("knobs");
 		knobMenuButton.addListener(this);
@@ -54,6 +60,11 @@ public:
 			setScene(Scenes::OscEdit);
 			if (setSceneCallback) setSceneCallback(Scenes::OscEdit);
 		}
+		else if (b == &controllerMenuButton)
+		{
+			setScene(Scenes::ControllerMenu);
+			if (setSceneCallback) setSceneCallback(Scenes::ControllerMenu);
+		}
 		else if (b == &knobMenuButton)
 		{
 			setScene(Scenes::KnobMenu);
@@ -73,18 +84,28 @@ public:
 
 		case Scenes::OscEdit:
 			oscEditButton.setToggleState(true, dontSendNotification);
+			controllerMenuButton.setToggleState(false, dontSendNotification);
+			knobMenuButton.setToggleState(false, dontSendNotification);
+			settingsMenuButton.setToggleState(false, dontSendNotification);
+			break;
+
+		case Scenes::ControllerMenu:
+			oscEditButton.setToggleState(false, dontSendNotification);
+			controllerMenuButton.setToggleState(true, dontSendNotification);
 			knobMenuButton.setToggleState(false, dontSendNotification);
 			settingsMenuButton.setToggleState(false, dontSendNotification);
 			break;
 
 		case Scenes::KnobMenu:
 			oscEditButton.setToggleState(false, dontSendNotification);
+			controllerMenuButton.setToggleState(false, dontSendNotification);
 			knobMenuButton.setToggleState(true, dontSendNotification);
 			settingsMenuButton.setToggleState(false, dontSendNotification);
 			break;
 
 		case Scenes::SettingsMenu:
 			oscEditButton.setToggleState(false, dontSendNotification);
+			controllerMenuButton.setToggleState(false, dontSendNotification);
 			knobMenuButton.setToggleState(false, dontSendNotification);
 			settingsMenuButton.setToggleState(true, dontSendNotification);
 			break;
@@ -97,6 +118,7 @@ public:
 		FlexBox fb;
 		fb.items.addArray({
 			FlexItem(oscEditButton).withFlex(1)
+			, FlexItem(controllerMenuButton).withFlex(1)
 			, FlexItem(knobMenuButton).withFlex(1)
 			, FlexItem(settingsMenuButton).withFlex(1)
 		});
@@ -107,7 +129,7 @@ public:
 	std::function<void(const Scenes)> setSceneCallback;
 
 private:
-	TextButton oscEditButton, knobMenuButton, settingsMenuButton;
+	TextButton oscEditButton, controllerMenuButton, knobMenuButton, settingsMenuButton;
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscvstMenuBar);
 };
 
@@ -141,7 +163,7 @@ public:
 			g.fillEllipse(area.getCentreX() - indicatorRadius / 2.0f, area.getBottomLeft().y - indicatorRadius * 2.0f, indicatorRadius, indicatorRadius);
 		}
 
-		if(oscMap.count(midiNoteNumber) != 0)
+		if(oscMap.count(getMidiOscKey(channel, midiNoteNumber)) != 0)
 		{
 			g.setColour(PatColours::pink);
 			g.fillEllipse(area.getCentreX() - indicatorRadius / 2.0f, area.getBottomLeft().y - indicatorRadius * 3.0f, indicatorRadius, indicatorRadius);
@@ -170,6 +192,7 @@ public:
 	void mouseUpOnKey(int midiNoteNumber, const MouseEvent& e) override {}
 
 	int lastKey = 0;
+	int channel = 0; // mappings shown for this channel, 0 = any
 	MidiOscMap& oscMap;
 	std::function<void(const int)> mouseDownOnKeyCallback;
 
@@ -183,6 +206,7 @@ private:
 */
 class OscvstAudioProcessorEditor
 	: public juce::AudioProcessorEditor
+	, public Timer
 {
 
 public:
@@ -193,11 +217,13 @@ public:
 	void paint(juce::Graphics&) override;
 	void resized() override;
 
-	OscObject* addOscObject(const int note, const String& path);
-	void removeOscObject(const int note);
+	OscObject* addOscObject(const int channel, const int note, const String& path);
+	void removeOscObject(const int channel, const int note);
 
 	void setScene(const Scenes _scene);
 
+	void timerCallback() override;
+
 private:
 	OscvstAudioProcessor& audioProcessor;
 	PatLookAndFeel patLookAndFeel;
@@ -205,6 +231,7 @@ private:
 	MidiOscMap& oscMap;
 	OscObjectComponent oscObjectComponent;
 	OscKeyboardComponent keyboardComponent;
+	ControllerMenuComponent controllerMenuComponent;
 	KnobMenuComponent knobMenuComponent;
 	SettingsMenuComponent settingsMenuComponent;
 	OwnedArray<SliderParameterAttachment> knobs;
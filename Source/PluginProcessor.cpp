@@ -21,7 +21,6 @@ OscvstAudioProcessor::OscvstAudioProcessor()
 #endif
 	)
 #endif
-	, random(Time::currentTimeMillis())
 	,
 	paramsState(*this, nullptr, Identifier("Oscvst"),
 		{
@@ -43,6 +42,7 @@ OscvstAudioProcessor::OscvstAudioProcessor()
 			std::make_unique<AudioParameterFloat>("knob16", "Knob 16", 0.f, 1.f, 0.f),
 		}
 		)
+	, dispatchThread([this]() { return this->dispatchEvents(); })
 {
 
 	// PARAMS
@@ -51,17 +51,34 @@ OscvstAudioProcessor::OscvstAudioProcessor()
 		knobs.emplace_back(paramsState.getRawParameterValue("knob" + String(i + 1)));
 	}
 
+	// CONTROLLERS
+	dirtyControllers.reserve(16 * 128 + 128 + 16);
+
+	// KNOB STREAMS
+	for (int i = 0; i < 16; ++i)
+	{
+		knobStreams.emplace_back(0, i, "/oscvst/knob" + String(i + 1));
+		lastKnobValues[i] = 0.0f;
+	}
+
 	// KEYBOARD
+	keyboardQueue.prepare(256);
+	uiEventQueue.prepare(256);
+	transportQueue.prepare(256);
+	analysisQueue.prepare(64);
 	keyboardState.addListener(this);
 
 	//// OSC
-	osc.sender.connect(osc.address, osc.port);
-	// TIMER
-	startTimer(osc.interval);
+	addDestination();
+	// DISPATCH
+	restartDispatchThread();
 }
 
 OscvstAudioProcessor::~OscvstAudioProcessor()
 {
+	keyboardState.removeListener(this);
+	dispatchThread.stop();
+	osc.destinations.clear();
 }
 
 //==============================================================================
@@ -129,6 +146,25 @@ void OscvstAudioProcessor::changeProgramName(int index, const juce::String& newN
 //==============================================================================
 void OscvstAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
+	const ScopedLock sl(mapLock);
+	blockClock.prepare(sampleRate);
+	transportTracker.reset();
+	audioAnalyser.prepare(sampleRate);
+
+	// room for the most latency a negative offset can report
+	latencyBuffer.setSize(getTotalNumOutputChannels(), (int)std::ceil(sampleRate * OscDestination::maxOffsetMs / 1000.0) + 1);
+	latencyBuffer.clear();
+	latencyWritePos = 0;
+	latencyDelay = 0;
+	eventQueue.prepare(osc.queueSize);
+	eventQueue.setOverflowPolicy(osc.overflowPolicy);
+
+	for (int i = 0; i < 16; ++i)
+	{
+		lastKnobValues[i] = knobs[i]->load();
+	}
+
+	updateLatency();
 }
 
 void OscvstAudioProcessor::releaseResources()
@@ -163,7 +199,125 @@ bool OscvstAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) co
 
 void OscvstAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-	keyboardState.processNextMidiBuffer(midiMessages, buffer.getNumSamples(), 0, true);
+	bool pushed = false;
+	int numEvents = 0;
+	OscEvent e;
+	e.timestamp = Time::getHighResolutionTicks();
+	const int64 blockStartTicks = blockClock.advance(e.timestamp, buffer.getNumSamples());
+
+	// hosts only hand over the knobs once per block, so every note in the block
+	// gets the value the host set for it rather than one guessed between blocks
+	OscKnobValues knobValues;
+	for (int i = 0; i < 16; ++i)
+	{
+		knobValues[i] = knobs[i]->load(std::memory_order_relaxed);
+	}
+
+	// PLAYHEAD, mappings with a seed start their numbers again when playback starts
+	AudioPlayHead::CurrentPositionInfo position;
+	double ppqPerSample = 0.0; // 0 = no beat grid to quantise to
+	if (auto* playHead = getPlayHead())
+	{
+		if (playHead->getCurrentPosition(position))
+		{
+			// in the queue with the notes, so only the ones after it get the new numbers
+			if (position.isPlaying && !wasPlaying)
+			{
+				OscEvent reseed = OscEvent::reseed(0);
+				reseed.timestamp = e.timestamp;
+				reseed.playTicks = blockStartTicks;
+				pushed |= eventQueue.push(reseed);
+			}
+			wasPlaying = position.isPlaying;
+
+			if (position.isPlaying && position.bpm > 0.0 && getSampleRate() > 0.0)
+				ppqPerSample = position.bpm / (60.0 * getSampleRate());
+
+			// TRANSPORT, always followed so that turning it on doesn't send a stale play or stop
+			const bool broadcastTransport = osc.broadcastTransport.load(std::memory_order_relaxed);
+			transportTracker.process(position, getSampleRate(), buffer.getNumSamples(), osc.transportSubdivisions.load(std::memory_order_relaxed)
+				, [&](OscHostTransportEvent& t)
+				{
+					if (!broadcastTransport) return;
+					t.timestamp = e.timestamp;
+					t.playTicks = blockClock.getTicks(t.sampleOffset);
+					pushed |= transportQueue.push(t);
+				});
+		}
+	}
+
+	for (const auto metadata : midiMessages)
+	{
+		if (!OscEvent::fromMidi(metadata.data, metadata.numBytes, metadata.samplePosition, e)) continue;
+		e.playTicks = blockClock.getTicks(metadata.samplePosition);
+
+		if (e.type == OscEvent::Type::NoteOn)
+		{
+			e.knobs = knobValues;
+			e.ppq = ppqPerSample > 0.0 ? position.ppqPosition + metadata.samplePosition * ppqPerSample : -1.0;
+			e.bpm = position.bpm;
+		}
+
+		// only what dispatchEvent() maps takes up room in the queue
+		if (e.type == OscEvent::Type::NoteOn || e.type == OscEvent::Type::Controller)
+		{
+			++numEvents;
+			pushed |= eventQueue.push(e);
+		}
+
+		if (e.type == OscEvent::Type::NoteOn || e.type == OscEvent::Type::NoteOff)
+		{
+			keyboardQueue.push(e);
+		}
+	}
+
+	// KNOB STREAMS
+	if (osc.streamKnobs.load(std::memory_order_relaxed))
+	{
+		for (int i = 0; i < 16; ++i)
+		{
+			// every change goes, the deadband is up to the dispatch thread
+			const float value = knobValues[i];
+			if (value == lastKnobValues[i]) continue;
+
+			OscEvent knobEvent = OscEvent::knob(i, value, 0);
+			knobEvent.timestamp = e.timestamp;
+			knobEvent.playTicks = blockStartTicks;
+
+			if (eventQueue.push(knobEvent))
+			{
+				++numEvents;
+				lastKnobValues[i] = value;
+				pushed = true;
+			}
+		}
+	}
+
+	// AUDIO ANALYSIS, the input is only read, it passes through untouched
+	if (osc.analyseAudio.load(std::memory_order_relaxed))
+	{
+		audioAnalyser.process(buffer.getArrayOfReadPointers(), getTotalNumInputChannels(), buffer.getNumSamples()
+			, osc.analysisRate.load(std::memory_order_relaxed), osc.analysisBands.load(std::memory_order_relaxed)
+			, osc.analysisLowHz.load(std::memory_order_relaxed), osc.analysisHighHz.load(std::memory_order_relaxed)
+			, [&](OscAudioAnalyser::Frame& frame)
+			{
+				frame.timestamp = e.timestamp;
+				frame.playTicks = blockClock.getTicks(frame.sampleOffset);
+				pushed |= analysisQueue.push(frame);
+			});
+	}
+	else
+	{
+		audioAnalyser.reset();
+	}
+
+	delayForLatency(buffer);
+
+	// events coalesced while the queue was full go back in as soon as there is room
+	pushed |= eventQueue.flushCoalesced();
+
+	if (numEvents > 0) osc.stats.eventsReceived.fetch_add((uint64)numEvents, std::memory_order_relaxed);
+	if (pushed) dispatchThread.wake();
 }
 
 //==============================================================================
@@ -187,9 +341,35 @@ void OscvstAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 			paramsState.state.removeChild(paramsState.state.getChildWithName("oscSettings"), nullptr);
 		}
 		ValueTree oscSettingsTree("oscSettings");
-		oscSettingsTree.setProperty("address", osc.address, nullptr);
-		oscSettingsTree.setProperty("port", osc.port, nullptr);
-		oscSettingsTree.setProperty("interval", osc.interval, nullptr);
+		oscSettingsTree.setProperty("batchWindow", osc.batchWindow, nullptr);
+		oscSettingsTree.setProperty("realtimePriority", osc.realtimePriority, nullptr);
+		oscSettingsTree.setProperty("affinityMask", (int)osc.affinityMask, nullptr);
+		oscSettingsTree.setProperty("queueSize", osc.queueSize, nullptr);
+		oscSettingsTree.setProperty("timetagAhead", osc.timetagAhead, nullptr);
+		oscSettingsTree.setProperty("streamKnobs", osc.streamKnobs.load(), nullptr);
+		oscSettingsTree.setProperty("overflowPolicy", (int)osc.overflowPolicy, nullptr);
+		oscSettingsTree.setProperty("publishStats", osc.publishStats, nullptr);
+		oscSettingsTree.setProperty("statsPath", osc.statsPublisher.getPath(), nullptr);
+		oscSettingsTree.setProperty("statsInterval", osc.statsInterval, nullptr);
+		oscSettingsTree.setProperty("statsDestinations", (int)osc.statsDestinations, nullptr);
+		oscSettingsTree.setProperty("broadcastTransport", osc.broadcastTransport.load(), nullptr);
+		oscSettingsTree.setProperty("transportSubdivisions", osc.transportSubdivisions.load(), nullptr);
+		oscSettingsTree.setProperty("transportPath", osc.transportPublisher.getPath(), nullptr);
+		oscSettingsTree.setProperty("transportDestinations", (int)osc.transportDestinations, nullptr);
+		oscSettingsTree.setProperty("analyseAudio", osc.analyseAudio.load(), nullptr);
+		oscSettingsTree.setProperty("analysisRate", osc.analysisRate.load(), nullptr);
+		oscSettingsTree.setProperty("analysisBands", osc.analysisBands.load(), nullptr);
+		oscSettingsTree.setProperty("analysisLowHz", osc.analysisLowHz.load(), nullptr);
+		oscSettingsTree.setProperty("analysisHighHz", osc.analysisHighHz.load(), nullptr);
+		oscSettingsTree.setProperty("analysisPath", osc.analysisPublisher.getPath(), nullptr);
+		oscSettingsTree.setProperty("analysisDestinations", (int)osc.analysisDestinations, nullptr);
+		ValueTree destinationsTree("destinations");
+		for (const auto* destination : osc.destinations)
+		{
+			destinationsTree.addChild(destination->toTree(), -1, nullptr);
+		}
+		oscSettingsTree.addChild(destinationsTree, -1, nullptr);
+
 		paramsState.state.addChild(oscSettingsTree, 0, nullptr);
 	}
 
@@ -211,6 +391,38 @@ void OscvstAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 		}
 	}
 
+	// CC MAP
+	{
+		if (paramsState.state.getChildWithName("ccMap").isValid())
+		{
+			paramsState.state.removeChild(paramsState.state.getChildWithName("ccMap"), nullptr);
+		}
+		if (!ccMap.empty())
+		{
+			ValueTree ccMapTree("ccMap");
+			for (const auto& p : ccMap)
+			{
+				ccMapTree.addChild(p.second.toTree(), 0, nullptr);
+			}
+
+			paramsState.state.addChild(ccMapTree, 0, nullptr);
+		}
+	}
+
+	// KNOB STREAMS
+	{
+		if (paramsState.state.getChildWithName("knobStreams").isValid())
+		{
+			paramsState.state.removeChild(paramsState.state.getChildWithName("knobStreams"), nullptr);
+		}
+		ValueTree knobStreamsTree("knobStreams");
+		for (const auto& knobStream : knobStreams)
+		{
+			knobStreamsTree.addChild(knobStream.toTree(), -1, nullptr);
+		}
+		paramsState.state.addChild(knobStreamsTree, 0, nullptr);
+	}
+
 	auto state = paramsState.copyState();
 	std::unique_ptr<XmlElement> xml(state.createXml());
 	copyXmlToBinary(*xml, destData);
@@ -230,18 +442,72 @@ void OscvstAudioProcessor::setStateInformation(const void* data, int sizeInBytes
 				const auto& oscSettingsTree = paramsState.state.getChildWithName("oscSettings");
 				if (oscSettingsTree.isValid())
 				{
-					osc.address = oscSettingsTree["address"];
-					osc.port = oscSettingsTree["port"];
-					osc.interval = oscSettingsTree["interval"];
-					osc.sender.disconnect();
-					osc.sender.connect(osc.address, osc.port);
-					startTimer(std::max(osc.interval, 1));
+					osc.batchWindow = oscSettingsTree.getProperty("batchWindow", osc.batchWindow);
+					osc.realtimePriority = oscSettingsTree.getProperty("realtimePriority", osc.realtimePriority);
+					osc.affinityMask = (uint32)(int)oscSettingsTree.getProperty("affinityMask", (int)osc.affinityMask);
+					osc.queueSize = oscSettingsTree.getProperty("queueSize", osc.queueSize);
+					osc.timetagAhead = oscSettingsTree.getProperty("timetagAhead", 0);
+					osc.streamKnobs = (bool)oscSettingsTree.getProperty("streamKnobs", false);
+					setOverflowPolicy((OscEventQueue::OverflowPolicy)(int)oscSettingsTree.getProperty("overflowPolicy", (int)osc.overflowPolicy));
+
+					// STATS
+					{
+						const ScopedLock sl(mapLock);
+						osc.publishStats = oscSettingsTree.getProperty("publishStats", false);
+						osc.statsPublisher.setPath(oscSettingsTree.getProperty("statsPath", "/oscvst/stats"));
+						osc.statsInterval = oscSettingsTree.getProperty("statsInterval", osc.statsInterval);
+						osc.statsDestinations = (uint32)(int)oscSettingsTree.getProperty("statsDestinations", 1);
+					}
+
+					// HOST TRANSPORT
+					{
+						const ScopedLock sl(mapLock);
+						osc.broadcastTransport = (bool)oscSettingsTree.getProperty("broadcastTransport", false);
+						osc.transportSubdivisions = jlimit(1, 16, (int)oscSettingsTree.getProperty("transportSubdivisions", 1));
+						osc.transportPublisher.setPath(oscSettingsTree.getProperty("transportPath", "/oscvst/transport"));
+						osc.transportDestinations = (uint32)(int)oscSettingsTree.getProperty("transportDestinations", 1);
+					}
+
+					// AUDIO ANALYSIS
+					{
+						const ScopedLock sl(mapLock);
+						osc.analyseAudio = (bool)oscSettingsTree.getProperty("analyseAudio", false);
+						osc.analysisRate = jlimit(1, 1000, (int)oscSettingsTree.getProperty("analysisRate", 30));
+						osc.analysisBands = jlimit(0, OscAudioAnalyser::maxBands, (int)oscSettingsTree.getProperty("analysisBands", 8));
+						osc.analysisLowHz = (float)oscSettingsTree.getProperty("analysisLowHz", 40.0f);
+						osc.analysisHighHz = (float)oscSettingsTree.getProperty("analysisHighHz", 16000.0f);
+						osc.analysisPublisher.setPath(oscSettingsTree.getProperty("analysisPath", "/oscvst/audio"));
+						osc.analysisDestinations = (uint32)(int)oscSettingsTree.getProperty("analysisDestinations", 1);
+					}
+
+					// DESTINATIONS
+					{
+						const ScopedLock sl(mapLock);
+						osc.destinations.clear();
+
+						const auto& destinationsTree = oscSettingsTree.getChildWithName("destinations");
+						for (int i = 0; i < destinationsTree.getNumChildren() && i < OscHandler::maxDestinations; ++i)
+						{
+							addDestination()->fromTree(destinationsTree.getChild(i));
+						}
+
+						// older states only had a single address and port
+						if (osc.destinations.isEmpty())
+						{
+							addDestination()->fromTree(oscSettingsTree);
+						}
+					}
+
+					restartDispatchThread();
+					updateLatency();
 				}
 			}
 
 			// OSC MAP
 			{
+				const ScopedLock sl(mapLock);
 				oscMap.clear();
+				dispatchTable.rebuild(oscMap);
 				const auto& oscMapTree = paramsState.state.getChildWithName("oscMap");
 				if (oscMapTree.isValid())
 				{
@@ -252,12 +518,17 @@ void OscvstAudioProcessor::setStateInformation(const void* data, int sizeInBytes
 						if (oscObjectTree.isValid())
 						{
 							const String& path = oscObjectTree["path"];
+							const int channel = oscObjectTree.getProperty("channel", 0);
 							const int note = oscObjectTree["note"];
-							OscObject* oscObject = addOscObject(note, path);
+							OscObject* oscObject = addOscObject(channel, note, path);
 							if (oscObject)
 							{
 								oscObject->useNote = oscObjectTree["useNote"];
 								oscObject->useVel = oscObjectTree["useVel"];
+								oscObject->destinations = (uint32)(int)oscObjectTree.getProperty("destinations", 1);
+								oscObject->seed = oscObjectTree.getProperty("seed", 0);
+								oscObject->quantise = (OscObject::Quantise)jlimit(0, (int)OscObject::Quantise::SixteenthTriplet, (int)oscObjectTree.getProperty("quantise", 0));
+								oscObject->resetRandom();
 
 								// RANDOM RANGE
 								{
@@ -283,11 +554,77 @@ void OscvstAudioProcessor::setStateInformation(const void* data, int sizeInBytes
 										oscObject->knobRanges[i].range.setEnd(rangeTree.getProperty("hi"));
 									}
 								}
+
+								oscObject->compile();
 							}
 						}
 					}
 				}
 			}
+
+			// CC MAP
+			{
+				const ScopedLock sl(mapLock);
+				ccMap.clear();
+				rebuildControllerTable();
+
+				const auto& ccMapTree = paramsState.state.getChildWithName("ccMap");
+				if (ccMapTree.isValid())
+				{
+					for (int i = 0; i < ccMapTree.getNumChildren(); ++i)
+					{
+						const auto& ccObjectTree = ccMapTree.getChild(i);
+						if (ccObjectTree.isValid())
+						{
+							OscControllerObject* ccObject = addControllerObject(ccObjectTree["channel"], ccObjectTree["controller"], ccObjectTree["path"]);
+							if (ccObject)
+							{
+								ccObject->is14Bit = ccObjectTree["is14Bit"];
+								ccObject->deadband = ccObjectTree["deadband"];
+								ccObject->maxRate = ccObjectTree["maxRate"];
+								ccObject->destinations = (uint32)(int)ccObjectTree.getProperty("destinations", 1);
+
+								const auto& rangeTree = ccObjectTree.getChildWithName("range");
+								if (rangeTree.isValid())
+								{
+									ccObject->range.isInt = rangeTree.getProperty("isInt");
+									ccObject->range.range.setStart(rangeTree.getProperty("lo"));
+									ccObject->range.range.setEnd(rangeTree.getProperty("hi"));
+								}
+
+								ccObject->compile();
+							}
+						}
+					}
+				}
+			}
+
+			// KNOB STREAMS
+			{
+				const ScopedLock sl(mapLock);
+
+				const auto& knobStreamsTree = paramsState.state.getChildWithName("knobStreams");
+				for (int i = 0; i < knobStreamsTree.getNumChildren() && i < (int)knobStreams.size(); ++i)
+				{
+					const auto& knobStreamTree = knobStreamsTree.getChild(i);
+					auto& knobStream = knobStreams[i];
+
+					knobStream.setPath(knobStreamTree["path"]);
+					knobStream.maxRate = knobStreamTree["maxRate"];
+					knobStream.destinations = (uint32)(int)knobStreamTree.getProperty("destinations", 1);
+					setKnobDeadband(i, knobStreamTree["deadband"]);
+
+					const auto& rangeTree = knobStreamTree.getChildWithName("range");
+					if (rangeTree.isValid())
+					{
+						knobStream.range.isInt = rangeTree.getProperty("isInt");
+						knobStream.range.range.setStart(rangeTree.getProperty("lo"));
+						knobStream.range.range.setEnd(rangeTree.getProperty("hi"));
+					}
+
+					knobStream.compile();
+				}
+			}
 		}
 	}
 
@@ -302,32 +639,62 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 }
 
 //==============================================================================
-void OscvstAudioProcessor::handleNoteOn(MidiKeyboardState* source, int midiChannel, int midiNoteNumber, float velocity)
+OscObject* OscvstAudioProcessor::addOscObject(const int channel, const int note, const String& path)
 {
-	midiBuffer.addEvent(MidiMessage::noteOn(midiChannel, midiNoteNumber, velocity), 0);
+	const ScopedLock sl(mapLock);
+
+	const int key = getMidiOscKey(channel, note);
+	if (oscMap.count(key) == 0)
+	{
+		oscMap.emplace(key, OscObject(channel, note, path));
+	}
+	else
+	{
+		oscMap[key] = OscObject(channel, note, path);
+	}
+	dispatchTable.rebuild(oscMap);
+
+	return &oscMap[key];
 }
 
 //==============================================================================
-OscObject* OscvstAudioProcessor::addOscObject(const int note, const String& path)
+bool OscvstAudioProcessor::removeOscObject(const int channel, const int note)
 {
-	if (oscMap.count(note) == 0)
+	const ScopedLock sl(mapLock);
+
+	const int key = getMidiOscKey(channel, note);
+	if (oscMap.count(key) != 0)
 	{
-		oscMap.emplace(note, OscObject(&random, note, path));
+		oscMap.erase(key);
+		dispatchTable.rebuild(oscMap);
+		return true;
 	}
 	else
 	{
-		oscMap[note] = OscObject(&random, note, path);
+		return false;
 	}
+}
+
+//==============================================================================
+OscControllerObject* OscvstAudioProcessor::addControllerObject(const int channel, const int controller, const String& path)
+{
+	const ScopedLock sl(mapLock);
 
-	return &oscMap[note];
+	const int key = getMidiOscKey(channel, controller);
+	ccMap[key] = OscControllerObject(channel, controller, path);
+	rebuildControllerTable();
+
+	return &ccMap[key];
 }
 
 //==============================================================================
-bool OscvstAudioProcessor::removeOscObject(const int note)
+bool OscvstAudioProcessor::removeControllerObject(const int channel, const int controller)
 {
-	if (oscMap.count(note) != 0)
+	const ScopedLock sl(mapLock);
+
+	if (ccMap.erase(getMidiOscKey(channel, controller)) != 0)
 	{
-		oscMap.erase(note);
+		rebuildControllerTable();
 		return true;
 	}
 	else
@@ -337,27 +704,455 @@ bool OscvstAudioProcessor::removeOscObject(const int note)
 }
 
 //==============================================================================
-void OscvstAudioProcessor::timerCallback()
+void OscvstAudioProcessor::rebuildControllerTable()
+{
+	const ScopedLock sl(mapLock);
+
+	// pending values may point at objects that are gone
+	for (auto& p : ccMap)
+	{
+		p.second.dirty = false;
+	}
+	for (auto& knobStream : knobStreams)
+	{
+		knobStream.dirty = false;
+	}
+	dirtyControllers.clear();
+
+	ccTable.rebuild(ccMap);
+}
+
+//==============================================================================
+void OscvstAudioProcessor::setKnobDeadband(const int knob, const float deadband)
+{
+	const ScopedLock sl(mapLock);
+
+	knobStreams[knob].deadband = jmax(0.0f, deadband);
+}
+
+//==============================================================================
+void OscvstAudioProcessor::setOverflowPolicy(const OscEventQueue::OverflowPolicy policy)
+{
+	osc.overflowPolicy = policy;
+	eventQueue.setOverflowPolicy(policy);
+}
+
+//==============================================================================
+OscDestination* OscvstAudioProcessor::addDestination()
+{
+	const ScopedLock sl(mapLock);
+
+	if (osc.destinations.size() >= OscHandler::maxDestinations) return nullptr;
+
+	auto* destination = osc.destinations.add(new OscDestination(osc.packetPool));
+	if (dispatchThread.isThreadRunning())
+	{
+		destination->start(osc.realtimePriority, osc.affinityMask);
+	}
+	return destination;
+}
+
+//==============================================================================
+// the destinations after it move down a bit, so every mask moves with them
+bool OscvstAudioProcessor::removeDestination(const int index)
+{
+	{
+		const ScopedLock sl(mapLock);
+
+		if (osc.destinations.size() <= 1 || !isPositiveAndBelow(index, osc.destinations.size())) return false;
+
+		const uint32 below = (1u << index) - 1;
+		auto removeBit = [below](const uint32 mask) { return (mask & below) | ((mask >> 1) & ~below); };
+
+		for (auto& p : oscMap)
+		{
+			p.second.destinations = removeBit(p.second.destinations);
+		}
+		for (auto& p : ccMap)
+		{
+			p.second.destinations = removeBit(p.second.destinations);
+		}
+		for (auto& knobStream : knobStreams)
+		{
+			knobStream.destinations = removeBit(knobStream.destinations);
+		}
+		osc.statsDestinations = removeBit(osc.statsDestinations);
+		osc.transportDestinations = removeBit(osc.transportDestinations);
+		osc.analysisDestinations = removeBit(osc.analysisDestinations);
+		destinationsToWake = 0;
+
+		osc.destinations.remove(index);
+	}
+
+	updateLatency();
+	return true;
+}
+
+//==============================================================================
+// destinations with a negative offset need the host to send notes early, the
+// plugin reports the earliest one as latency and everything else is held back
+void OscvstAudioProcessor::updateLatency()
+{
+	int earliest = 0;
+	bool anyOffset = false;
+	{
+		const ScopedLock sl(mapLock);
+		for (auto* destination : osc.destinations)
+		{
+			earliest = jmin(earliest, destination->offset);
+			anyOffset = anyOffset || destination->offset != 0;
+		}
+	}
+
+	// without offsets nothing is held, messages go out as soon as they can like before
+	const int lookaheadMs = -earliest;
+	lookaheadTicks.store(anyOffset ? Time::secondsToHighResolutionTicks(lookaheadMs / 1000.0) : -1);
+	setLatencySamples(roundToInt(lookaheadMs * getSampleRate() / 1000.0));
+}
+
+//==============================================================================
+// AUDIO THREAD, holds the audio back by the latency reported, so that it
+// still lines up with other tracks once the host compensates for it
+void OscvstAudioProcessor::delayForLatency(AudioBuffer<float>& buffer)
+{
+	const int size = latencyBuffer.getNumSamples();
+	const int delay = jlimit(0, jmax(0, size - 1), getLatencySamples());
+
+	// a new delay starts from silence rather than whatever the line held before
+	if (delay != latencyDelay)
+	{
+		latencyBuffer.clear();
+		latencyDelay = delay;
+	}
+	if (delay == 0) return;
+
+	const int numChannels = jmin(buffer.getNumChannels(), latencyBuffer.getNumChannels());
+	const int numSamples = buffer.getNumSamples();
+
+	for (int c = 0; c < numChannels; ++c)
+	{
+		float* data = buffer.getWritePointer(c);
+		float* line = latencyBuffer.getWritePointer(c);
+		int writePos = latencyWritePos;
+		int readPos = writePos - delay;
+		if (readPos < 0) readPos += size;
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			line[writePos] = data[i];
+			data[i] = line[readPos];
+			if (++writePos == size) writePos = 0;
+			if (++readPos == size) readPos = 0;
+		}
+	}
+
+	latencyWritePos = (latencyWritePos + numSamples) % size;
+}
+
+//==============================================================================
+void OscvstAudioProcessor::restartDispatchThread()
 {
-	if (midiBuffer.getNumEvents() == 0) return;
+	dispatchThread.setBatchWindow(osc.batchWindow);
+	dispatchThread.start(osc.realtimePriority, osc.affinityMask);
 
-	std::vector<float> knobValues;
-	for (const auto v : knobs)
+	const ScopedLock sl(mapLock);
+	for (auto* destination : osc.destinations)
 	{
-		knobValues.push_back(*v);
+		destination->start(osc.realtimePriority, osc.affinityMask);
 	}
+}
 
-	for (const auto& it : midiBuffer)
+//==============================================================================
+int OscvstAudioProcessor::dispatchEvents()
+{
+	const ScopedLock sl(mapLock);
+
+	osc.stats.updateHighWater(eventQueue.getNumReady());
+
+	// beats first, notes on a beat should follow it
+	OscHostTransportEvent t;
+	while (transportQueue.pop(t))
 	{
-		const MidiMessage& msg = it.getMessage();
-		const int note = msg.getNoteNumber();
-		const float vel = msg.getVelocity() / 127.0f;
+		osc.queueLatency.recordTicks(t.timestamp, Time::getHighResolutionTicks());
+		const int64 encodeStart = Time::getHighResolutionTicks();
+		send(osc.transportPublisher.render(t), osc.transportPublisher.getEncodedSize(), osc.transportDestinations, t.timestamp, encodeStart, t.playTicks);
+	}
 
-		if (oscMap.count(note) != 0)
+	OscAudioAnalyser::Frame frame;
+	while (analysisQueue.pop(frame))
+	{
+		osc.queueLatency.recordTicks(frame.timestamp, Time::getHighResolutionTicks());
+		for (int c = 0; c < frame.numChannels; ++c)
 		{
-			oscMap[note].send(osc.sender, vel, knobValues);
+			const int64 encodeStart = Time::getHighResolutionTicks();
+			send(osc.analysisPublisher.render(c, frame), osc.analysisPublisher.getEncodedSize(c), osc.analysisDestinations, frame.timestamp, encodeStart, frame.playTicks);
 		}
 	}
 
-	midiBuffer.clear();
+	OscEvent e;
+	while (uiEventQueue.pop(e))
+	{
+		osc.queueLatency.recordTicks(e.timestamp, Time::getHighResolutionTicks());
+		dispatchEvent(e);
+	}
+	while (eventQueue.pop(e))
+	{
+		osc.queueLatency.recordTicks(e.timestamp, Time::getHighResolutionTicks());
+		dispatchEvent(e);
+	}
+
+	int nextFlush = flushControllers();
+
+	const int nextStats = flushStats();
+	if (nextStats >= 0) nextFlush = nextFlush >= 0 ? jmin(nextFlush, nextStats) : nextStats;
+
+	for (int i = 0; i < osc.destinations.size(); ++i)
+	{
+		if (destinationsToWake & (1u << i)) osc.destinations[i]->wake();
+	}
+	destinationsToWake = 0;
+
+	return nextFlush;
+}
+
+//==============================================================================
+// encodes once into the packet pool, every destination in the mask shares that copy,
+// destinations hold it until playTicks plus their offset, 0 goes out as soon as possible,
+// scheduled packets are held even without offsets unless the timetag is doing it
+void OscvstAudioProcessor::send(const char* data, const int size, const uint32 destinationMask, const int64 eventTicks, const int64 encodeStartTicks, const int64 playTicks, const bool scheduled)
+{
+	const int64 lookahead = lookaheadTicks.load(std::memory_order_relaxed);
+	const int64 heardTicks = playTicks != 0 ? playTicks + jmax((int64)0, lookahead) : 0;
+	const int64 releaseTicks = lookahead >= 0 || (scheduled && osc.timetagAhead <= 0) ? heardTicks : 0;
+	const int index = osc.packetPool.acquire(data, size, eventTicks, getTimeTag(heardTicks), releaseTicks);
+	if (index < 0)
+	{
+		osc.stats.poolDrops.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	osc.encodeLatency.recordTicks(encodeStartTicks, osc.packetPool.getEncodedTicks(index));
+	osc.stats.messagesEncoded.fetch_add(1, std::memory_order_relaxed);
+
+	for (int i = 0; i < osc.destinations.size(); ++i)
+	{
+		if ((destinationMask & (1u << i)) && osc.destinations[i]->enqueue(index))
+		{
+			destinationsToWake |= 1u << i;
+		}
+	}
+
+	osc.packetPool.release(index);
+}
+
+//==============================================================================
+// when the event should happen plus the time given to get there, or immediately with timetags off
+uint64 OscvstAudioProcessor::getTimeTag(const int64 playTicks) const
+{
+	if (osc.timetagAhead <= 0 || playTicks == 0) return OscEncoding::immediately;
+
+	const auto aheadTicks = Time::secondsToHighResolutionTicks(osc.timetagAhead / 1000.0);
+	return timeTagClock.toTimeTag(playTicks + aheadTicks);
+}
+
+//==============================================================================
+// from the note to the next point on the mapping's beat grid, 0 when on it or the host isn't playing
+int64 OscvstAudioProcessor::getTicksToGrid(const OscEvent& e, const OscObject::Quantise quantise)
+{
+	const double grid = OscObject::getGridLength(quantise);
+	if (grid <= 0.0 || e.ppq < 0.0 || e.bpm <= 0.0 || e.playTicks == 0) return 0;
+
+	// notes a hair past a grid line from rounding still count as on it
+	const double next = std::ceil(e.ppq / grid - 1.0e-6) * grid;
+	return Time::secondsToHighResolutionTicks(jmax(0.0, next - e.ppq) * 60.0 / e.bpm);
+}
+
+//==============================================================================
+void OscvstAudioProcessor::dispatchEvent(const OscEvent& e)
+{
+	switch (e.type)
+	{
+	case OscEvent::Type::NoteOn:
+		if (OscObject* oscObject = dispatchTable.find(e.channel, e.note))
+		{
+			const int64 encodeStart = Time::getHighResolutionTicks();
+			const int64 gridTicks = getTicksToGrid(e, oscObject->quantise);
+			send(oscObject->render(e.value, e.knobs), oscObject->getEncodedSize(), oscObject->destinations, e.timestamp, encodeStart, e.playTicks + gridTicks, gridTicks > 0);
+		}
+		break;
+
+	case OscEvent::Type::Controller:
+		dispatchController(e);
+		break;
+
+	case OscEvent::Type::Reseed:
+		for (auto& p : oscMap)
+		{
+			p.second.resetRandom();
+		}
+		break;
+
+	case OscEvent::Type::Knob:
+		if (knobStreams[e.note].setValue(e.value))
+		{
+			knobStreams[e.note].timestamp = e.timestamp;
+			knobStreams[e.note].playTicks = e.playTicks;
+			dirtyControllers.push_back(&knobStreams[e.note]);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+//==============================================================================
+void OscvstAudioProcessor::dispatchController(const OscEvent& e)
+{
+	OscControllerObject* ccObject = nullptr;
+
+	// the LSB of a 14 bit pair belongs to the MSB's mapping
+	if (32 <= e.note && e.note < 64)
+	{
+		ccObject = ccTable.find(e.channel, e.note - 32);
+		if (ccObject && !ccObject->is14Bit) ccObject = nullptr;
+	}
+	if (!ccObject)
+	{
+		ccObject = ccTable.find(e.channel, e.note);
+	}
+
+	if (ccObject && ccObject->update(e.note, e.rawValue))
+	{
+		ccObject->timestamp = e.timestamp;
+		ccObject->playTicks = e.playTicks;
+		dirtyControllers.push_back(ccObject);
+	}
+}
+
+//==============================================================================
+// sends the latest value of every controller that changed, returns the ms until a rate limited one is due, or -1
+int OscvstAudioProcessor::flushControllers()
+{
+	if (dirtyControllers.empty()) return -1;
+
+	const double now = Time::getMillisecondCounterHiRes();
+	double waitMs = std::numeric_limits<double>::max();
+
+	auto it = dirtyControllers.begin();
+	while (it != dirtyControllers.end())
+	{
+		OscControllerObject* ccObject = *it;
+
+		switch (ccObject->checkFlush(now, waitMs))
+		{
+		case OscControllerObject::FlushResult::Wait:
+			++it;
+			continue;
+
+		case OscControllerObject::FlushResult::Send:
+		{
+			const int64 encodeStart = Time::getHighResolutionTicks();
+			send(ccObject->render(now), ccObject->getEncodedSize(), ccObject->destinations, ccObject->timestamp, encodeStart, ccObject->playTicks);
+			break;
+		}
+
+		case OscControllerObject::FlushResult::Unchanged:
+			break;
+		}
+
+		it = dirtyControllers.erase(it);
+	}
+
+	return dirtyControllers.empty() ? -1 : jmax(1, (int)std::ceil(waitMs));
+}
+
+//==============================================================================
+// publishes the counters when they are due, returns the ms until the next report, or -1
+int OscvstAudioProcessor::flushStats()
+{
+	if (!osc.publishStats) return -1;
+
+	const double now = Time::getMillisecondCounterHiRes();
+	if (now < nextStatsMs) return jmax(1, (int)std::ceil(nextStatsMs - now));
+
+	nextStatsMs = now + jmax(10, osc.statsInterval);
+
+	uint64 datagrams = 0, bytes = 0, bundles = 0, destinationDrops = 0, transportDrops = 0, sendErrors = 0, reconnects = 0;
+	uint64 shmLag = 0, shmOverruns = 0, syscalls = 0;
+	for (auto* destination : osc.destinations)
+	{
+		const auto& counters = destination->getCounters();
+		datagrams += counters.numDatagrams.load(std::memory_order_relaxed);
+		syscalls += counters.numSyscalls.load(std::memory_order_relaxed);
+		bytes += counters.numBytes.load(std::memory_order_relaxed);
+		bundles += counters.numBundles.load(std::memory_order_relaxed);
+		transportDrops += counters.numDropped.load(std::memory_order_relaxed);
+		sendErrors += counters.numSendErrors.load(std::memory_order_relaxed);
+		reconnects += counters.numReconnects.load(std::memory_order_relaxed);
+		shmLag = jmax(shmLag, counters.readerLag.load(std::memory_order_relaxed));
+		shmOverruns += counters.numOverruns.load(std::memory_order_relaxed);
+		destinationDrops += destination->getNumDropped();
+	}
+
+	using Counter = OscStatsPublisher::Counter;
+	auto publish = [this](const Counter counter, const uint64 value)
+	{
+		send(osc.statsPublisher.render(counter, value), osc.statsPublisher.getEncodedSize(counter), osc.statsDestinations, 0, 0, 0);
+	};
+
+	publish(Counter::Events, osc.stats.eventsReceived.load(std::memory_order_relaxed));
+	publish(Counter::Messages, osc.stats.messagesEncoded.load(std::memory_order_relaxed));
+	publish(Counter::Datagrams, datagrams);
+	publish(Counter::Bytes, bytes);
+	publish(Counter::Bundles, bundles);
+	publish(Counter::QueueDrops, eventQueue.getNumOverflows());
+	publish(Counter::PoolDrops, osc.stats.poolDrops.load(std::memory_order_relaxed));
+	publish(Counter::DestinationDrops, destinationDrops);
+	publish(Counter::TransportDrops, transportDrops);
+	publish(Counter::QueueHighWater, osc.stats.queueHighWater.load(std::memory_order_relaxed));
+	publish(Counter::SendErrors, sendErrors);
+	publish(Counter::Reconnects, reconnects);
+	publish(Counter::ShmLag, shmLag);
+	publish(Counter::ShmOverruns, shmOverruns);
+
+	const float perSyscall = syscalls > 0 ? (float)datagrams / (float)syscalls : 0.0f;
+	send(osc.statsPublisher.renderRatio(Counter::DatagramsPerSyscall, perSyscall)
+		, osc.statsPublisher.getEncodedSize(Counter::DatagramsPerSyscall), osc.statsDestinations, 0, 0, 0);
+
+	return jmax(10, osc.statsInterval);
+}
+
+//==============================================================================
+void OscvstAudioProcessor::updateKeyboardState()
+{
+	const ScopedValueSetter<bool> svs(updatingKeyboard, true);
+
+	OscEvent e;
+	while (keyboardQueue.pop(e))
+	{
+		if (e.type == OscEvent::Type::NoteOn)
+			keyboardState.noteOn(e.channel, e.note, e.value);
+		else
+			keyboardState.noteOff(e.channel, e.note, e.value);
+	}
+}
+
+//==============================================================================
+void OscvstAudioProcessor::handleNoteOn(MidiKeyboardState* source, int midiChannel, int midiNoteNumber, float velocity)
+{
+	if (updatingKeyboard) return;
+
+	OscEvent e = OscEvent::noteOn(midiChannel, midiNoteNumber, velocity, 0);
+	e.timestamp = Time::getHighResolutionTicks();
+	e.playTicks = e.timestamp;
+	for (int i = 0; i < 16; ++i)
+	{
+		e.knobs[i] = knobs[i]->load(std::memory_order_relaxed);
+	}
+
+	osc.stats.eventsReceived.fetch_add(1, std::memory_order_relaxed);
+	if (uiEventQueue.push(e))
+	{
+		dispatchThread.wake();
+	}
 }
\ No newline at end of file
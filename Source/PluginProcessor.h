@@ -11,14 +11,58 @@
 #include <JuceHeader.h>
 
 #include "OscObject.h"
+#include "OscControllerObject.h"
+#include "OscEventQueue.h"
+#include "OscDispatchTable.h"
+#include "OscDispatchThread.h"
+#include "OscPacketPool.h"
+#include "OscDestination.h"
+#include "OscLatencyHistogram.h"
+#include "OscStats.h"
+#include "OscTimeTag.h"
+#include "OscHostTransport.h"
+#include "OscAudioAnalysis.h"
 
 //==============================================================================
 struct OscHandler
 {
-	OSCSender sender;
-	String address = "127.0.0.1";
-	int port = 1234;
-	int interval = 100;
+	static constexpr int maxDestinations = 32; // one bit each in a mapping's destinations
+
+	OscPacketPool packetPool{ 4096 }; // destinations with an offset keep packets here until they're due
+	OwnedArray<OscDestination> destinations;
+	int batchWindow = 0; // microseconds
+	int timetagAhead = 0; // ms, messages are timetagged this far after their note, 0 = no timetags
+	bool realtimePriority = false;
+	uint32 affinityMask = 0; // 0 = any cpu
+	int queueSize = 4096;
+	OscEventQueue::OverflowPolicy overflowPolicy = OscEventQueue::OverflowPolicy::DropOldest;
+	std::atomic<bool> streamKnobs{ false }; // send knob changes without waiting for a note
+
+	// LATENCY, both written by the dispatch thread, each destination has its own send histograms
+	OscLatencyHistogram queueLatency; // entering processBlock -> dispatch thread
+	OscLatencyHistogram encodeLatency; // rendering the message into the packet pool
+
+	// STATS
+	OscStats stats;
+	OscStatsPublisher statsPublisher; // path changes under mapLock
+	bool publishStats = false;
+	int statsInterval = 1000; // ms
+	uint32 statsDestinations = 1;
+
+	// HOST TRANSPORT
+	std::atomic<bool> broadcastTransport{ false };
+	std::atomic<int> transportSubdivisions{ 1 }; // ticks per beat
+	OscHostTransportPublisher transportPublisher; // path changes under mapLock
+	uint32 transportDestinations = 1;
+
+	// AUDIO ANALYSIS
+	std::atomic<bool> analyseAudio{ false };
+	std::atomic<int> analysisRate{ 30 }; // reports per second
+	std::atomic<int> analysisBands{ 8 };
+	std::atomic<float> analysisLowHz{ 40.0f };
+	std::atomic<float> analysisHighHz{ 16000.0f };
+	OscAudioAnalysisPublisher analysisPublisher; // path changes under mapLock
+	uint32 analysisDestinations = 1;
 };
 
 //==============================================================================
@@ -27,7 +71,6 @@ struct OscHandler
 class OscvstAudioProcessor
 	: public juce::AudioProcessor
 	, public MidiKeyboardStateListener
-	, public Timer
 {
 public:
 	//==============================================================================
@@ -72,22 +115,72 @@ public:
 	std::vector<std::atomic<float>*> knobs;
 	AudioProcessorValueTreeState paramsState;
 	MidiOscMap oscMap;
+	MidiCcOscMap ccMap;
+	std::vector<OscControllerObject> knobStreams; // one per knob, controller = knob index
 	OscHandler osc;
+	OscEventQueue eventQueue;
 	std::function<void()> onStateLoadedCallback;
 
-	OscObject* addOscObject(const int note, const String& path);
-	bool removeOscObject(const int note);
+	OscObject* addOscObject(const int channel, const int note, const String& path);
+	bool removeOscObject(const int channel, const int note);
+	OscControllerObject* addControllerObject(const int channel, const int controller, const String& path);
+	bool removeControllerObject(const int channel, const int controller);
+	void rebuildControllerTable();
+	void setKnobDeadband(const int knob, const float deadband);
 
-	void timerCallback() override;
+	void setOverflowPolicy(const OscEventQueue::OverflowPolicy policy);
+	OscDestination* addDestination();
+	bool removeDestination(const int index);
+	void updateLatency();
+	void restartDispatchThread();
+
+	int dispatchEvents();
+	void updateKeyboardState();
+
+	CriticalSection mapLock; // held while the dispatch thread reads oscMap and ccMap, never taken by the audio thread
 
 private:
 
+	// notes played on the on screen keyboard
 	void handleNoteOn(MidiKeyboardState* source, int midiChannel, int midiNoteNumber, float velocity) override;
-	void handleNoteOff(MidiKeyboardState* source, int midiChannel, int midiNoteNumber, float velocity) override {}; 
+	void handleNoteOff(MidiKeyboardState* source, int midiChannel, int midiNoteNumber, float velocity) override {};
+
+	void dispatchEvent(const OscEvent& e);
+	void dispatchController(const OscEvent& e);
+	int flushControllers();
+	int flushStats();
+	void send(const char* data, const int size, const uint32 destinationMask, const int64 eventTicks, const int64 encodeStartTicks, const int64 playTicks, const bool scheduled = false);
+	uint64 getTimeTag(const int64 playTicks) const;
+	static int64 getTicksToGrid(const OscEvent& e, const OscObject::Quantise quantise);
+	void delayForLatency(AudioBuffer<float>& buffer);
 
 	//==============================================================================
-	MidiBuffer midiBuffer;
-	Random random;
+	std::array<float, 16> lastKnobValues; // audio thread only
+
+	OscEventQueue keyboardQueue; // audio thread -> on screen keyboard
+	OscEventQueue uiEventQueue; // on screen keyboard -> dispatch thread
+	OscSpscQueue<OscHostTransportEvent> transportQueue; // audio thread -> dispatch thread
+	OscHostTransportTracker transportTracker; // audio thread only
+	OscSpscQueue<OscAudioAnalyser::Frame> analysisQueue; // audio thread -> dispatch thread
+	OscAudioAnalyser audioAnalyser; // audio thread only
+
+	// LATENCY, audio thread only, allocated in prepareToPlay
+	AudioBuffer<float> latencyBuffer;
+	int latencyWritePos{ 0 };
+	int latencyDelay{ 0 };
+	bool updatingKeyboard{ false };
+
+	bool wasPlaying{ false }; // audio thread only
+	OscBlockClock blockClock; // audio thread only
+	OscTimeTagClock timeTagClock;
+	std::atomic<int64> lookaheadTicks{ -1 }; // the reported latency, added to every release time, -1 = no offsets
+
+	OscDispatchTable<OscObject> dispatchTable;
+	OscDispatchTable<OscControllerObject> ccTable;
+	std::vector<OscControllerObject*> dirtyControllers;
+	uint32 destinationsToWake{ 0 }; // dispatch thread only
+	double nextStatsMs{ 0.0 }; // dispatch thread only
+	OscDispatchThread dispatchThread;
 
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscvstAudioProcessor)
@@ -12,6 +12,8 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "OscObjectComponent.h"
+#include "StatsPanelComponent.h"
 
 //==============================================================================
 /*
@@ -25,7 +27,42 @@ public:
 	SettingsMenuComponent(OscvstAudioProcessor& _audioProcessor)
 		: audioProcessor(_audioProcessor)
 		, osc(_audioProcessor.osc)
+		, addDestinationButton("addDestination", true)
+		, removeDestinationButton("removeDestination", false)
+		, transportDestinationsButton(_audioProcessor.mapLock)
+		, analysisDestinationsButton(_audioProcessor.mapLock)
+		, statsPanel(_audioProcessor)
 	{
+		// DESTINATIONS
+		destinationLabel.setText("destination", dontSendNotification);
+		destinationLabel.setJustificationType(Justification::centred);
+		addAndMakeVisible(destinationLabel);
+
+		destinationSelector.onChange = [this]() { this->reset(); };
+		addAndMakeVisible(destinationSelector);
+
+		addDestinationButton.onClick = [this]()
+		{
+			if (audioProcessor.addDestination())
+			{
+				updateDestinationSelector();
+				destinationSelector.setSelectedItemIndex(osc.destinations.size() - 1);
+			}
+		};
+		addAndMakeVisible(addDestinationButton);
+
+		removeDestinationButton.onClick = [this]()
+		{
+			if (audioProcessor.removeDestination(destinationSelector.getSelectedItemIndex()))
+			{
+				updateDestinationSelector();
+				reset();
+			}
+		};
+		addAndMakeVisible(removeDestinationButton);
+
+		updateDestinationSelector();
+
 		// LABELS
 		addressLabel.setText("address", dontSendNotification);
 		addressLabel.setJustificationType(Justification::centred);
@@ -35,42 +72,285 @@ public:
 		portLabel.setJustificationType(Justification::centred);
 		addAndMakeVisible(portLabel);
 
-		intervalLabel.setText("interval", dontSendNotification);
-		intervalLabel.setJustificationType(Justification::centred);
-		addAndMakeVisible(intervalLabel);
+		batchLabel.setText("batch (us)", dontSendNotification);
+		batchLabel.setJustificationType(Justification::centred);
+		addAndMakeVisible(batchLabel);
+
+		aheadLabel.setText("ahead (ms)", dontSendNotification);
+		aheadLabel.setJustificationType(Justification::centred);
+		addAndMakeVisible(aheadLabel);
+
+		affinityLabel.setText("cpu mask", dontSendNotification);
+		affinityLabel.setJustificationType(Justification::centred);
+		addAndMakeVisible(affinityLabel);
+
+		mtuLabel.setText("mtu", dontSendNotification);
+		mtuLabel.setJustificationType(Justification::centred);
+		addAndMakeVisible(mtuLabel);
+
+		offsetLabel.setText("offset (ms)", dontSendNotification);
+		offsetLabel.setJustificationType(Justification::centred);
+		addAndMakeVisible(offsetLabel);
+
+		overflowLabel.setText("overflow", dontSendNotification);
+		overflowLabel.setJustificationType(Justification::centred);
+		addAndMakeVisible(overflowLabel);
 
 		// INPUTS
 		const String& inputRestrictions = "0123456789";
 
 		addressInput.setJustification(Justification::verticallyCentred);
 		addressInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
-		addressInput.setText(osc.address, dontSendNotification);
+		addressInput.setText(getDestination()->address, dontSendNotification);
 		addressInput.setInputRestrictions(0, inputRestrictions + ".");
 		addressInput.addListener(this);
 		addAndMakeVisible(addressInput);
 
 		portInput.setJustification(Justification::verticallyCentred);
 		portInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
-		portInput.setText(String(osc.port), dontSendNotification);
+		portInput.setText(String(getDestination()->port), dontSendNotification);
 		portInput.setInputRestrictions(0, inputRestrictions);
 		portInput.addListener(this);
 		addAndMakeVisible(portInput);
 
-		intervalInput.setJustification(Justification::verticallyCentred);
-		intervalInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
-		intervalInput.setText(String(osc.interval), dontSendNotification);
-		intervalInput.setInputRestrictions(0, inputRestrictions);
-		intervalInput.addListener(this);
-		addAndMakeVisible(intervalInput);
+		batchInput.setJustification(Justification::verticallyCentred);
+		batchInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		batchInput.setText(String(osc.batchWindow), dontSendNotification);
+		batchInput.setInputRestrictions(0, inputRestrictions);
+		batchInput.addListener(this);
+		addAndMakeVisible(batchInput);
+
+		aheadInput.setJustification(Justification::verticallyCentred);
+		aheadInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		aheadInput.setText(String(osc.timetagAhead), dontSendNotification);
+		aheadInput.setInputRestrictions(0, inputRestrictions);
+		aheadInput.addListener(this);
+		addAndMakeVisible(aheadInput);
+
+		affinityInput.setJustification(Justification::verticallyCentred);
+		affinityInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		affinityInput.setText(String(osc.affinityMask), dontSendNotification);
+		affinityInput.setInputRestrictions(0, inputRestrictions);
+		affinityInput.addListener(this);
+		addAndMakeVisible(affinityInput);
+
+		mtuInput.setJustification(Justification::verticallyCentred);
+		mtuInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		mtuInput.setText(String(getDestination()->mtu), dontSendNotification);
+		mtuInput.setInputRestrictions(0, inputRestrictions);
+		mtuInput.addListener(this);
+		addAndMakeVisible(mtuInput);
+
+		offsetInput.setJustification(Justification::verticallyCentred);
+		offsetInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		offsetInput.setText(String(getDestination()->offset), dontSendNotification);
+		offsetInput.setInputRestrictions(0, inputRestrictions + "-");
+		offsetInput.addListener(this);
+		addAndMakeVisible(offsetInput);
+
+		// PROTOCOL
+		protocolSelector.addItem("udp", (int)OscDestination::Protocol::Udp + 1);
+		protocolSelector.addItem("tcp", (int)OscDestination::Protocol::Tcp + 1);
+	   #if OSCVST_HAS_SHARED_MEMORY
+		protocolSelector.addItem("shm", (int)OscDestination::Protocol::SharedMemory + 1);
+		protocolSelector.addItem("unix", (int)OscDestination::Protocol::UnixSocket + 1);
+	   #endif
+		protocolSelector.setSelectedId((int)getDestination()->protocol + 1, dontSendNotification);
+		protocolSelector.onChange = [this]()
+		{
+			getDestination()->setProtocol((OscDestination::Protocol)(protocolSelector.getSelectedId() - 1));
+			updateAddressRestrictions();
+			updateMulticastInputs();
+		};
+		addAndMakeVisible(protocolSelector);
+		updateAddressRestrictions();
+
+		// MULTICAST
+		ttlLabel.setText("ttl", dontSendNotification);
+		ttlLabel.setJustificationType(Justification::centred);
+		addAndMakeVisible(ttlLabel);
+
+		ttlInput.setJustification(Justification::verticallyCentred);
+		ttlInput.setInputRestrictions(3, inputRestrictions);
+		ttlInput.addListener(this);
+		addAndMakeVisible(ttlInput);
+
+		interfaceInput.setJustification(Justification::verticallyCentred);
+		interfaceInput.setInputRestrictions(0, inputRestrictions + ".");
+		interfaceInput.setTextToShowWhenEmpty("interface", PatColours::darkPink);
+		interfaceInput.addListener(this);
+		addAndMakeVisible(interfaceInput);
+
+		multicastLoopToggle.setButtonText("loop?");
+		multicastLoopToggle.onClick = [this]()
+		{
+			auto* destination = getDestination();
+			auto options = destination->multicast;
+			options.loopback = multicastLoopToggle.getToggleState();
+			destination->setMulticast(options);
+		};
+		addAndMakeVisible(multicastLoopToggle);
+
+		updateMulticastInputs();
+
+		// REALTIME
+		realtimeToggle.setButtonText("realtime?");
+		realtimeToggle.setToggleState(osc.realtimePriority, dontSendNotification);
+		realtimeToggle.onClick = [this]()
+		{
+			osc.realtimePriority = realtimeToggle.getToggleState();
+			audioProcessor.restartDispatchThread();
+		};
+		addAndMakeVisible(realtimeToggle);
+
+		// BUNDLES
+		bundleToggle.setButtonText("bundle?");
+		bundleToggle.setToggleState(getDestination()->useBundles, dontSendNotification);
+		bundleToggle.onClick = [this]()
+		{
+			auto* destination = getDestination();
+			destination->setBundling(bundleToggle.getToggleState(), destination->mtu);
+		};
+		addAndMakeVisible(bundleToggle);
+
+		// OVERFLOW POLICY
+		overflowSelector.addItem("drop oldest", (int)OscEventQueue::OverflowPolicy::DropOldest + 1);
+		overflowSelector.addItem("drop newest", (int)OscEventQueue::OverflowPolicy::DropNewest + 1);
+		overflowSelector.addItem("coalesce", (int)OscEventQueue::OverflowPolicy::Coalesce + 1);
+		overflowSelector.setSelectedId((int)osc.overflowPolicy + 1, dontSendNotification);
+		overflowSelector.onChange = [this]()
+		{
+			audioProcessor.setOverflowPolicy((OscEventQueue::OverflowPolicy)(overflowSelector.getSelectedId() - 1));
+		};
+		addAndMakeVisible(overflowSelector);
+
+		// HOST TRANSPORT
+		transportToggle.setButtonText("transport?");
+		transportToggle.setToggleState(osc.broadcastTransport, dontSendNotification);
+		transportToggle.onClick = [this]()
+		{
+			osc.broadcastTransport = transportToggle.getToggleState();
+		};
+		addAndMakeVisible(transportToggle);
+
+		transportPathInput.setJustification(Justification::verticallyCentred);
+		transportPathInput.setInputRestrictions(0, String("/0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_"));
+		transportPathInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		transportPathInput.setText(osc.transportPublisher.getPath(), dontSendNotification);
+		transportPathInput.addListener(this);
+		addAndMakeVisible(transportPathInput);
+
+		for (int i : { 1, 2, 3, 4 })
+			subdivisionSelector.addItem(String(i) + "/beat", i);
+		subdivisionSelector.setSelectedId(osc.transportSubdivisions, dontSendNotification);
+		subdivisionSelector.onChange = [this]()
+		{
+			osc.transportSubdivisions = subdivisionSelector.getSelectedId();
+		};
+		addAndMakeVisible(subdivisionSelector);
+
+		transportDestinationsButton.setDestinations(&osc.destinations);
+		transportDestinationsButton.setTarget(&osc.transportDestinations);
+		addAndMakeVisible(transportDestinationsButton);
+
+		// AUDIO ANALYSIS
+		analysisToggle.setButtonText("audio?");
+		analysisToggle.setToggleState(osc.analyseAudio, dontSendNotification);
+		analysisToggle.onClick = [this]()
+		{
+			osc.analyseAudio = analysisToggle.getToggleState();
+		};
+		addAndMakeVisible(analysisToggle);
+
+		analysisPathInput.setInputRestrictions(0, String("/0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_"));
+		analysisRateInput.setInputRestrictions(4, inputRestrictions);
+		analysisBandsInput.setInputRestrictions(2, inputRestrictions);
+		for (auto* input : { &analysisPathInput, &analysisRateInput, &analysisBandsInput })
+		{
+			input->setJustification(Justification::verticallyCentred);
+			input->setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+			input->addListener(this);
+			addAndMakeVisible(input);
+		}
+		analysisPathInput.setText(osc.analysisPublisher.getPath(), dontSendNotification);
+		analysisRateInput.setText(String(osc.analysisRate), dontSendNotification);
+		analysisBandsInput.setText(String(osc.analysisBands), dontSendNotification);
+
+		analysisRateLabel.setText("per s", dontSendNotification);
+		analysisBandsLabel.setText("bands", dontSendNotification);
+		for (auto* label : { &analysisRateLabel, &analysisBandsLabel })
+		{
+			label->setJustificationType(Justification::centred);
+			addAndMakeVisible(label);
+		}
+
+		analysisDestinationsButton.setDestinations(&osc.destinations);
+		analysisDestinationsButton.setTarget(&osc.analysisDestinations);
+		addAndMakeVisible(analysisDestinationsButton);
+
+		// STATS
+		statsButton.setButtonText("stats");
+		statsButton.setClickingTogglesState(true);
+		statsButton.onClick = [this]()
+		{
+			statsPanel.setVisible(statsButton.getToggleState());
+		};
+		addAndMakeVisible(statsButton);
+
+		addChildComponent(statsPanel);
 	}
 
 	~SettingsMenuComponent() override
 	{
 	}
 
+	OscDestination* getDestination() const
+	{
+		return osc.destinations[jlimit(0, osc.destinations.size() - 1, destinationSelector.getSelectedItemIndex())];
+	}
+
+	// local protocols use a name or path instead of an ip address
+	void updateAddressRestrictions()
+	{
+		if (OscDestination::isLocal(getDestination()->protocol))
+			addressInput.setInputRestrictions(0, "/._-0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
+		else
+			addressInput.setInputRestrictions(0, "0123456789.");
+	}
+
+	void updateMulticastInputs()
+	{
+		const auto* destination = getDestination();
+
+		ttlInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		ttlInput.setText(String(destination->multicast.ttl), dontSendNotification);
+
+		interfaceInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		interfaceInput.setText(destination->multicast.interfaceAddress, dontSendNotification);
+
+		multicastLoopToggle.setToggleState(destination->multicast.loopback, dontSendNotification);
+
+		// only means something for group addresses
+		const bool isMulticast = destination->protocol == OscDestination::Protocol::Udp
+			&& OscMulticastOptions::isMulticastAddress(destination->address);
+		for (auto* c : std::initializer_list<Component*>{ &ttlLabel, &ttlInput, &interfaceInput, &multicastLoopToggle })
+			c->setVisible(isMulticast);
+	}
+
+	void updateDestinationSelector()
+	{
+		const int selected = jmax(0, destinationSelector.getSelectedItemIndex());
+
+		destinationSelector.clear(dontSendNotification);
+		for (int i = 0; i < osc.destinations.size(); ++i)
+			destinationSelector.addItem(String(i + 1), i + 1);
+		destinationSelector.setSelectedItemIndex(jmin(selected, osc.destinations.size() - 1), dontSendNotification);
+	}
+
 	void updateInputs(TextEditor& e)
 	{
 		const auto* ep = &e;
+		auto* destination = getDestination();
 
 		if (ep == &addressInput)
 		{
@@ -81,40 +361,123 @@ public:
 				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
 				e.setText(text, dontSendNotification);
 			}
-			osc.address = text;
-			osc.sender.disconnect();
-			osc.sender.connect(osc.address, osc.port);
+			destination->setAddress(text, destination->port);
+			updateMulticastInputs();
 		}
 		else if (ep == &portInput)
+		{
+			const String& text = e.getText();
+			int port = 1234;
+			if (text.isEmpty())
+			{
+				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+				e.setText(String(port), dontSendNotification);
+			}
+			else
+			{
+				port = CharacterFunctions::getIntValue<int, CharPointer_UTF8>(text.toUTF8());
+			}
+			destination->setAddress(destination->address, port);
+		}
+		else if (ep == &batchInput)
+		{
+			const String& text = e.getText();
+			if (text.isEmpty())
+			{
+				osc.batchWindow = 0;
+				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+				e.setText(String(osc.batchWindow), dontSendNotification);
+			}
+			else
+			{
+				osc.batchWindow = CharacterFunctions::getIntValue<int, CharPointer_UTF8>(e.getText().toUTF8());
+			}
+			audioProcessor.restartDispatchThread();
+		}
+		else if (ep == &aheadInput)
+		{
+			const ScopedLock sl(audioProcessor.mapLock);
+			osc.timetagAhead = jlimit(0, 10000, e.getText().getIntValue());
+			e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+			e.setText(String(osc.timetagAhead), dontSendNotification);
+		}
+		else if (ep == &affinityInput)
 		{
 			const String& text = e.getText();
 			if (text.isEmpty())
 			{
-				osc.port = 1234;
+				osc.affinityMask = 0;
 				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
-				e.setText(String(osc.port), dontSendNotification);
+				e.setText(String(osc.affinityMask), dontSendNotification);
 			}
 			else
 			{
-				osc.port = CharacterFunctions::getIntValue<int, CharPointer_UTF8>(text.toUTF8());
+				osc.affinityMask = (uint32)text.getLargeIntValue();
 			}
-			osc.sender.disconnect();
-			osc.sender.connect(osc.address, std::max(0, osc.port));
+			audioProcessor.restartDispatchThread();
 		}
-		else if (ep == &intervalInput)
+		else if (ep == &mtuInput)
 		{
 			const String& text = e.getText();
+			int mtu = 1472;
 			if (text.isEmpty())
 			{
-				osc.interval = 100;
 				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
-				e.setText(String(osc.interval), dontSendNotification);
+				e.setText(String(mtu), dontSendNotification);
 			}
 			else
 			{
-				osc.interval = CharacterFunctions::getIntValue<int, CharPointer_UTF8>(e.getText().toUTF8());
+				mtu = CharacterFunctions::getIntValue<int, CharPointer_UTF8>(text.toUTF8());
+			}
+			destination->setBundling(destination->useBundles, mtu);
+			if (destination->mtu != mtu)
+			{
+				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+				e.setText(String(destination->mtu), dontSendNotification);
+			}
+		}
+		else if (ep == &offsetInput)
+		{
+			destination->setOffset(e.getText().getIntValue());
+			e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+			e.setText(String(destination->offset), dontSendNotification);
+			audioProcessor.updateLatency();
+		}
+		else if (ep == &transportPathInput)
+		{
+			const ScopedLock sl(audioProcessor.mapLock);
+			if (!osc.transportPublisher.setPath(e.getText().isEmpty() ? "/oscvst/transport" : e.getText()) || e.getText().isEmpty())
+			{
+				e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+				e.setText(osc.transportPublisher.getPath(), dontSendNotification);
 			}
-			audioProcessor.startTimer(std::max(osc.interval, 1));
+		}
+		else if (ep == &analysisPathInput)
+		{
+			const ScopedLock sl(audioProcessor.mapLock);
+			osc.analysisPublisher.setPath(e.getText().isEmpty() ? "/oscvst/audio" : e.getText());
+			e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+			e.setText(osc.analysisPublisher.getPath(), dontSendNotification);
+		}
+		else if (ep == &analysisRateInput)
+		{
+			osc.analysisRate = jlimit(1, 1000, e.getText().getIntValue());
+			e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+			e.setText(String(osc.analysisRate), dontSendNotification);
+		}
+		else if (ep == &analysisBandsInput)
+		{
+			osc.analysisBands = jlimit(0, OscAudioAnalyser::maxBands, e.getText().getIntValue());
+			e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+			e.setText(String(osc.analysisBands), dontSendNotification);
+		}
+		else if (ep == &ttlInput || ep == &interfaceInput)
+		{
+			auto options = destination->multicast;
+			options.ttl = jlimit(0, 255, ttlInput.getText().getIntValue());
+			options.interfaceAddress = interfaceInput.getText().trim();
+			destination->setMulticast(options);
+			updateMulticastInputs();
 		}
 	}
 
@@ -135,18 +498,64 @@ public:
 
 	void reset()
 	{
+		updateDestinationSelector();
+		const auto* destination = getDestination();
+
 		addressInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
-		addressInput.setText(String(osc.address), dontSendNotification);
+		addressInput.setText(String(destination->address), dontSendNotification);
 
 		portInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
-		portInput.setText(String(osc.port), dontSendNotification);
+		portInput.setText(String(destination->port), dontSendNotification);
+
+		protocolSelector.setSelectedId((int)destination->protocol + 1, dontSendNotification);
+		updateAddressRestrictions();
+		updateMulticastInputs();
+
+		batchInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		batchInput.setText(String(osc.batchWindow), dontSendNotification);
 
-		intervalInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
-		intervalInput.setText(String(osc.interval), dontSendNotification);
+		aheadInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		aheadInput.setText(String(osc.timetagAhead), dontSendNotification);
+
+		affinityInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		affinityInput.setText(String(osc.affinityMask), dontSendNotification);
+
+		realtimeToggle.setToggleState(osc.realtimePriority, dontSendNotification);
+
+		mtuInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		mtuInput.setText(String(destination->mtu), dontSendNotification);
+
+		bundleToggle.setToggleState(destination->useBundles, dontSendNotification);
+
+		offsetInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		offsetInput.setText(String(destination->offset), dontSendNotification);
+
+		overflowSelector.setSelectedId((int)osc.overflowPolicy + 1, dontSendNotification);
+
+		transportToggle.setToggleState(osc.broadcastTransport, dontSendNotification);
+		transportPathInput.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		transportPathInput.setText(osc.transportPublisher.getPath(), dontSendNotification);
+		subdivisionSelector.setSelectedId(osc.transportSubdivisions, dontSendNotification);
+		transportDestinationsButton.updateText();
+
+		analysisToggle.setToggleState(osc.analyseAudio, dontSendNotification);
+		for (auto* input : { &analysisPathInput, &analysisRateInput, &analysisBandsInput })
+			input->setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		analysisPathInput.setText(osc.analysisPublisher.getPath(), dontSendNotification);
+		analysisRateInput.setText(String(osc.analysisRate), dontSendNotification);
+		analysisBandsInput.setText(String(osc.analysisBands), dontSendNotification);
+		analysisDestinationsButton.updateText();
 	}
 
 	void resized() override
 	{
+		FlexBox destinationFb;
+		destinationFb.flexDirection = FlexBox::Direction::row;
+		destinationFb.items.add(FlexItem(destinationLabel).withFlex(1));
+		destinationFb.items.add(FlexItem(destinationSelector).withFlex(1).withMargin(8));
+		destinationFb.items.add(FlexItem(addDestinationButton).withWidth(16.0f).withHeight(16.0f).withMargin(FlexItem::Margin(8, 4, 0, 4)));
+		destinationFb.items.add(FlexItem(removeDestinationButton).withWidth(16.0f).withHeight(16.0f).withMargin(FlexItem::Margin(8, 8, 0, 4)));
+
 		FlexBox addressFb;
 		addressFb.flexDirection = FlexBox::Direction::row;
 		addressFb.items.add(FlexItem(addressLabel).withFlex(1));
@@ -156,26 +565,101 @@ public:
 		portFb.flexDirection = FlexBox::Direction::row;
 		portFb.items.add(FlexItem(portLabel).withFlex(1));
 		portFb.items.add(FlexItem(portInput).withFlex(1).withMargin(8));
+		portFb.items.add(FlexItem(protocolSelector).withFlex(1).withMargin(8));
+
+		FlexBox multicastFb;
+		multicastFb.flexDirection = FlexBox::Direction::row;
+		multicastFb.items.add(FlexItem(ttlLabel).withFlex(1));
+		multicastFb.items.add(FlexItem(ttlInput).withFlex(1).withMargin(8));
+		multicastFb.items.add(FlexItem(interfaceInput).withFlex(2).withMargin(8));
+		multicastFb.items.add(FlexItem(multicastLoopToggle).withFlex(1));
+
+		FlexBox batchFb;
+		batchFb.flexDirection = FlexBox::Direction::row;
+		batchFb.items.add(FlexItem(batchLabel).withFlex(1));
+		batchFb.items.add(FlexItem(batchInput).withFlex(1).withMargin(8));
+		batchFb.items.add(FlexItem(aheadLabel).withFlex(1));
+		batchFb.items.add(FlexItem(aheadInput).withFlex(1).withMargin(8));
+
+		FlexBox threadFb;
+		threadFb.flexDirection = FlexBox::Direction::row;
+		threadFb.items.add(FlexItem(realtimeToggle).withFlex(1));
+		threadFb.items.add(FlexItem(affinityLabel).withFlex(1));
+		threadFb.items.add(FlexItem(affinityInput).withFlex(1).withMargin(8));
 
-		FlexBox intervalFb;
-		intervalFb.flexDirection = FlexBox::Direction::row;
-		intervalFb.items.add(FlexItem(intervalLabel).withFlex(1));
-		intervalFb.items.add(FlexItem(intervalInput).withFlex(1).withMargin(8));
+		FlexBox bundleFb;
+		bundleFb.flexDirection = FlexBox::Direction::row;
+		bundleFb.items.add(FlexItem(bundleToggle).withFlex(1));
+		bundleFb.items.add(FlexItem(mtuLabel).withFlex(1));
+		bundleFb.items.add(FlexItem(mtuInput).withFlex(1).withMargin(8));
+		bundleFb.items.add(FlexItem(offsetLabel).withFlex(1));
+		bundleFb.items.add(FlexItem(offsetInput).withFlex(1).withMargin(8));
+
+		FlexBox transportFb;
+		transportFb.flexDirection = FlexBox::Direction::row;
+		transportFb.items.add(FlexItem(transportToggle).withFlex(1));
+		transportFb.items.add(FlexItem(transportPathInput).withFlex(2).withMargin(8));
+		transportFb.items.add(FlexItem(subdivisionSelector).withFlex(1).withMargin(8));
+		transportFb.items.add(FlexItem(transportDestinationsButton).withFlex(1).withMargin(8));
+
+		FlexBox analysisFb;
+		analysisFb.flexDirection = FlexBox::Direction::row;
+		analysisFb.items.add(FlexItem(analysisToggle).withFlex(1));
+		analysisFb.items.add(FlexItem(analysisPathInput).withFlex(2).withMargin(8));
+		analysisFb.items.add(FlexItem(analysisRateLabel).withFlex(1));
+		analysisFb.items.add(FlexItem(analysisRateInput).withFlex(1).withMargin(8));
+		analysisFb.items.add(FlexItem(analysisBandsLabel).withFlex(1));
+		analysisFb.items.add(FlexItem(analysisBandsInput).withFlex(1).withMargin(8));
+		analysisFb.items.add(FlexItem(analysisDestinationsButton).withFlex(1).withMargin(8));
+
+		FlexBox overflowFb;
+		overflowFb.flexDirection = FlexBox::Direction::row;
+		overflowFb.items.add(FlexItem(overflowLabel).withFlex(1));
+		overflowFb.items.add(FlexItem(overflowSelector).withFlex(1).withMargin(8));
+		overflowFb.items.add(FlexItem(statsButton).withFlex(1).withMargin(8));
 
 		FlexBox mainFb;
 		mainFb.flexDirection = FlexBox::Direction::column;
 		mainFb.justifyContent = FlexBox::JustifyContent::spaceAround;
+		mainFb.items.add(FlexItem(destinationFb).withFlex(1).withMaxHeight(50.0f));
 		mainFb.items.add(FlexItem(addressFb).withFlex(1).withMaxHeight(50.0f));
 		mainFb.items.add(FlexItem(portFb).withFlex(1).withMaxHeight(50.0f));
-		mainFb.items.add(FlexItem(intervalFb).withFlex(1).withMaxHeight(50.0f));
+		mainFb.items.add(FlexItem(multicastFb).withFlex(1).withMaxHeight(50.0f));
+		mainFb.items.add(FlexItem(batchFb).withFlex(1).withMaxHeight(50.0f));
+		mainFb.items.add(FlexItem(threadFb).withFlex(1).withMaxHeight(50.0f));
+		mainFb.items.add(FlexItem(bundleFb).withFlex(1).withMaxHeight(50.0f));
+		mainFb.items.add(FlexItem(transportFb).withFlex(1).withMaxHeight(50.0f));
+		mainFb.items.add(FlexItem(analysisFb).withFlex(1).withMaxHeight(50.0f));
+		mainFb.items.add(FlexItem(overflowFb).withFlex(1).withMaxHeight(50.0f));
 
 		mainFb.performLayout(getLocalBounds().toFloat());
+
+		// covers everything above the last row, so the stats button stays reachable
+		statsPanel.setBounds(getLocalBounds().withBottom(overflowSelector.getY() - 8));
 	}
 
 private:
 	OscHandler& osc;
 	OscvstAudioProcessor& audioProcessor;
-	Label addressLabel, portLabel, intervalLabel;
-	TextEditor addressInput, portInput, intervalInput;
+	Label addressLabel, portLabel, batchLabel, aheadLabel, affinityLabel, mtuLabel, offsetLabel, overflowLabel;
+	TextEditor addressInput, portInput, batchInput, aheadInput, affinityInput, mtuInput, offsetInput;
+	PatToggleButton realtimeToggle, bundleToggle;
+	ComboBox overflowSelector;
+	Label destinationLabel;
+	ComboBox destinationSelector, protocolSelector;
+	Label ttlLabel;
+	TextEditor ttlInput, interfaceInput;
+	PatToggleButton multicastLoopToggle;
+	PatToggleButton transportToggle;
+	TextEditor transportPathInput;
+	ComboBox subdivisionSelector;
+	DestinationsButton transportDestinationsButton;
+	PatToggleButton analysisToggle;
+	Label analysisRateLabel, analysisBandsLabel;
+	TextEditor analysisPathInput, analysisRateInput, analysisBandsInput;
+	DestinationsButton analysisDestinationsButton;
+	TextButton statsButton;
+	StatsPanelComponent statsPanel;
+	AddOrRemoveButton addDestinationButton, removeDestinationButton;
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SettingsMenuComponent)
 };
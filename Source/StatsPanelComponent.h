@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+	StatsPanelComponent.h
+	Created: 17 Oct 2026 7:52:40pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "PatLookAndFeel.h"
+#include "DestinationsButton.h"
+
+//==============================================================================
+/*
+	How long events spend in each stage on the way out, in microseconds.
+	Send and total are combined over every destination. The top row sets up
+	publishing the counters over OSC.
+*/
+class StatsPanelComponent
+	: public Component
+	, public TextEditor::Listener
+	, private Timer
+{
+public:
+
+	StatsPanelComponent(OscvstAudioProcessor& _audioProcessor)
+		: audioProcessor(_audioProcessor)
+		, destinationsButton(_audioProcessor.mapLock)
+	{
+		auto& osc = audioProcessor.osc;
+
+		// PUBLISH
+		publishToggle.setButtonText("publish?");
+		publishToggle.setToggleState(osc.publishStats, dontSendNotification);
+		publishToggle.onClick = [this]()
+		{
+			const ScopedLock sl(audioProcessor.mapLock);
+			audioProcessor.osc.publishStats = publishToggle.getToggleState();
+		};
+		addAndMakeVisible(publishToggle);
+
+		pathInput.setInputRestrictions(0, String("/0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_"));
+		intervalInput.setInputRestrictions(6, "0123456789");
+		for (auto* input : { &pathInput, &intervalInput })
+		{
+			input->setJustification(Justification::verticallyCentred);
+			input->addListener(this);
+			addAndMakeVisible(input);
+		}
+
+		destinationsButton.setDestinations(&osc.destinations);
+		destinationsButton.setTarget(&osc.statsDestinations);
+		addAndMakeVisible(destinationsButton);
+
+		reset();
+
+		// LATENCY
+		resetButton.setButtonText("reset");
+		resetButton.onClick = [this]()
+		{
+			auto& osc = audioProcessor.osc;
+			osc.queueLatency.reset();
+			osc.encodeLatency.reset();
+			for (auto* destination : osc.destinations)
+			{
+				destination->sendLatency.reset();
+				destination->totalLatency.reset();
+			}
+			repaint();
+		};
+		addAndMakeVisible(resetButton);
+	}
+
+	void reset()
+	{
+		auto& osc = audioProcessor.osc;
+
+		publishToggle.setToggleState(osc.publishStats, dontSendNotification);
+		setInputText(pathInput, osc.statsPublisher.getPath());
+		setInputText(intervalInput, String(osc.statsInterval));
+		destinationsButton.updateText();
+	}
+
+	void updateInputs(TextEditor& e)
+	{
+		auto& osc = audioProcessor.osc;
+		const ScopedLock sl(audioProcessor.mapLock);
+
+		if (&e == &pathInput)
+		{
+			if (!osc.statsPublisher.setPath(e.getText().isEmpty() ? "/oscvst/stats" : e.getText()))
+				setInputText(pathInput, osc.statsPublisher.getPath());
+		}
+		else if (&e == &intervalInput)
+		{
+			osc.statsInterval = jmax(10, e.getText().getIntValue());
+			setInputText(intervalInput, String(osc.statsInterval));
+		}
+	}
+
+	void textEditorReturnKeyPressed(TextEditor& e) override
+	{
+		updateInputs(e);
+	}
+
+	void textEditorEscapeKeyPressed(TextEditor& e) override
+	{
+		updateInputs(e);
+	}
+
+	void textEditorFocusLost(TextEditor& e) override
+	{
+		updateInputs(e);
+	}
+
+	void visibilityChanged() override
+	{
+		if (isVisible())
+		{
+			reset();
+			startTimerHz(4);
+		}
+		else
+		{
+			stopTimer();
+		}
+	}
+
+	void paint(Graphics& g) override
+	{
+		g.fillAll(getLookAndFeel().findColour(ResizableWindow::backgroundColourId));
+
+		auto& osc = audioProcessor.osc;
+
+		Array<const OscLatencyHistogram*> send, total;
+		for (const auto* destination : osc.destinations)
+		{
+			send.add(&destination->sendLatency);
+			total.add(&destination->totalLatency);
+		}
+
+		const std::pair<const char*, OscLatencyHistogram::Snapshot> rows[] = {
+			{ "queue", osc.queueLatency.getSnapshot() },
+			{ "encode", osc.encodeLatency.getSnapshot() },
+			{ "send", OscLatencyHistogram::combine(send) },
+			{ "total", OscLatencyHistogram::combine(total) }
+		};
+
+		auto area = getLocalBounds().withTrimmedTop(publishHeight).withTrimmedBottom(40).reduced(8);
+		const int rowHeight = area.getHeight() / 7;
+		const float columnWidth = area.getWidth() / 6.0f;
+
+		auto drawRow = [&](const StringArray& cells)
+		{
+			auto row = area.removeFromTop(rowHeight);
+			for (int i = 0; i < cells.size(); ++i)
+			{
+				g.drawText(cells[i], Rectangle<float>(row.getX() + i * columnWidth, (float)row.getY(), columnWidth, (float)rowHeight)
+					, i == 0 ? Justification::centredLeft : Justification::centredRight);
+			}
+		};
+
+		g.setColour(PatColours::darkPink);
+		drawRow({ "us", "p50", "p99", "p999", "max", "count" });
+
+		g.setColour(PatColours::pink);
+		for (const auto& row : rows)
+		{
+			const auto& s = row.second;
+			drawRow({ row.first, String(roundToInt(s.p50)), String(roundToInt(s.p99)), String(roundToInt(s.p999))
+				, String(roundToInt(s.max)), String((int64)s.count) });
+		}
+
+		// SHARED MEMORY, the furthest behind reader and every overrun
+		// SENDS, how many datagrams each syscall carried, then the shared memory readers
+		uint64 datagrams = 0, syscalls = 0, shmLag = 0, shmOverruns = 0;
+		for (auto* destination : osc.destinations)
+		{
+			const auto& counters = destination->getCounters();
+			datagrams += counters.numDatagrams.load(std::memory_order_relaxed);
+			syscalls += counters.numSyscalls.load(std::memory_order_relaxed);
+			shmLag = jmax(shmLag, counters.readerLag.load(std::memory_order_relaxed));
+			shmOverruns += counters.numOverruns.load(std::memory_order_relaxed);
+		}
+		const double perSyscall = syscalls > 0 ? (double)datagrams / (double)syscalls : 0.0;
+		drawRow({ "batch", "", "", "", "per call", String(perSyscall, 2) });
+		drawRow({ "shm", "", "lag", String((int64)shmLag), "overruns", String((int64)shmOverruns) });
+	}
+
+	void resized() override
+	{
+		FlexBox publishFb;
+		publishFb.flexDirection = FlexBox::Direction::row;
+		publishFb.items.add(FlexItem(publishToggle).withFlex(1));
+		publishFb.items.add(FlexItem(pathInput).withFlex(2).withMargin(6));
+		publishFb.items.add(FlexItem(intervalInput).withFlex(1).withMargin(6));
+		publishFb.items.add(FlexItem(destinationsButton).withFlex(1).withMargin(6));
+		publishFb.performLayout(getLocalBounds().removeFromTop(publishHeight).toFloat());
+
+		resetButton.setBounds(getLocalBounds().removeFromBottom(40).withSizeKeepingCentre(80, 28));
+	}
+
+private:
+	static constexpr int publishHeight = 40;
+
+	void setInputText(TextEditor& e, const String& text)
+	{
+		e.setColour(TextEditor::textColourId, PatColours::pink); // weird workaround because setText uses wrong colour?
+		e.setText(text, dontSendNotification);
+	}
+
+	void timerCallback() override
+	{
+		repaint();
+	}
+
+	OscvstAudioProcessor& audioProcessor;
+
+	PatToggleButton publishToggle;
+	TextEditor pathInput, intervalInput;
+	DestinationsButton destinationsButton;
+	TextButton resetButton;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StatsPanelComponent)
+};
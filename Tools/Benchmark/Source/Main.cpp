@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+	Main.cpp
+	Created: 17 Oct 2026 9:04:12pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+// Runs OscvstAudioProcessor without a host, feeding processBlock synthetic
+// MIDI and sending to a UDP sink on localhost, then prints the results as JSON
+// so runs from different builds can be diffed.
+//
+//	OscvstBenchmark --density 8 --block 256 --mappings 128 --seconds 10
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+
+//==============================================================================
+struct BenchmarkOptions
+{
+	double sampleRate{ 48000.0 };
+	int blockSize{ 256 };
+	int density{ 8 }; // note ons per block
+	int mappings{ 128 };
+	int knobs{ 0 }; // knob ranges per mapping
+	double seconds{ 10.0 };
+	bool realtime{ false }; // wait out each block like a host would
+	bool bundles{ false };
+	int port{ 0 }; // 0 picks a free one
+	int64 seed{ 1 };
+
+	static BenchmarkOptions fromArgs(const ArgumentList& args)
+	{
+		BenchmarkOptions o;
+		auto get = [&args](const char* option, const String& fallback)
+		{
+			return args.containsOption(option) ? args.getValueForOption(option) : fallback;
+		};
+
+		o.sampleRate = get("--rate", String(o.sampleRate)).getDoubleValue();
+		o.blockSize = jlimit(1, 8192, get("--block", String(o.blockSize)).getIntValue());
+		o.density = jlimit(0, 4096, get("--density", String(o.density)).getIntValue());
+		o.mappings = jlimit(1, 16 * 128, get("--mappings", String(o.mappings)).getIntValue());
+		o.knobs = jlimit(0, 16, get("--knobs", String(o.knobs)).getIntValue());
+		o.seconds = jmax(0.1, get("--seconds", String(o.seconds)).getDoubleValue());
+		o.realtime = args.containsOption("--realtime");
+		o.bundles = args.containsOption("--bundles");
+		o.port = get("--port", String(o.port)).getIntValue();
+		o.seed = get("--seed", String(o.seed)).getLargeIntValue();
+		return o;
+	}
+};
+
+//==============================================================================
+// counts whatever arrives, one datagram may be a bundle of several messages
+class UdpSink : public Thread
+{
+public:
+
+	UdpSink()
+		: Thread("oscvst benchmark sink")
+	{}
+
+	~UdpSink() override
+	{
+		stopThread(1000);
+	}
+
+	bool open(const int port)
+	{
+		if (!socket.bindToPort(port, "127.0.0.1")) return false;
+		startThread();
+		return true;
+	}
+
+	int getPort() const
+	{
+		return socket.getBoundPort();
+	}
+
+	void run() override
+	{
+		HeapBlock<char> buffer(65536);
+		while (!threadShouldExit())
+		{
+			if (socket.waitUntilReady(true, 50) <= 0) continue;
+
+			const int size = socket.read(buffer, 65536, false);
+			if (size <= 0) continue;
+
+			numDatagrams.fetch_add(1, std::memory_order_relaxed);
+			numBytes.fetch_add((uint64)size, std::memory_order_relaxed);
+		}
+	}
+
+	std::atomic<uint64> numDatagrams{ 0 };
+	std::atomic<uint64> numBytes{ 0 };
+
+private:
+	DatagramSocket socket{ false };
+};
+
+//==============================================================================
+static var toJson(const OscLatencyHistogram::Snapshot& s)
+{
+	DynamicObject::Ptr o = new DynamicObject();
+	o->setProperty("count", (int64)s.count);
+	o->setProperty("p50", s.p50);
+	o->setProperty("p99", s.p99);
+	o->setProperty("p999", s.p999);
+	o->setProperty("max", s.max);
+	return o.get();
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	ArgumentList args(argc, argv);
+	if (args.containsOption("--help|-h"))
+	{
+		std::cout << "OscvstBenchmark [--rate 48000] [--block 256] [--density 8] [--mappings 128] [--knobs 0]\n"
+			"                [--seconds 10] [--realtime] [--bundles] [--port 0] [--seed 1]\n";
+		return 0;
+	}
+
+	const auto options = BenchmarkOptions::fromArgs(args);
+	ScopedJuceInitialiser_GUI juceInitialiser;
+
+	UdpSink sink;
+	if (!sink.open(options.port))
+	{
+		std::cerr << "couldn't bind the sink to port " << options.port << "\n";
+		return 1;
+	}
+
+	// SETUP
+	auto processor = std::make_unique<OscvstAudioProcessor>();
+	processor->osc.destinations[0]->setAddress("127.0.0.1", sink.getPort());
+	processor->osc.destinations[0]->setBundling(options.bundles, processor->osc.destinations[0]->mtu);
+
+	for (int i = 0; i < options.mappings; ++i)
+	{
+		const int channel = i / 128 + 1;
+		const int note = i % 128;
+		auto* oscObject = processor->addOscObject(channel, note, "/bench/" + String(channel) + "/" + String(note));
+
+		const ScopedLock sl(processor->mapLock);
+		for (int k = 0; k < options.knobs; ++k)
+			oscObject->knobRanges[k].inUse = true;
+		oscObject->compile();
+	}
+
+	processor->setPlayConfigDetails(0, 2, options.sampleRate, options.blockSize);
+	processor->prepareToPlay(options.sampleRate, options.blockSize);
+
+	// RUN
+	AudioBuffer<float> buffer(2, options.blockSize);
+	MidiBuffer midi;
+	midi.ensureSize((size_t)options.density * 8);
+	Random random(options.seed);
+
+	const int numBlocks = jmax(1, (int)(options.seconds * options.sampleRate / options.blockSize));
+	const double blockMs = 1000.0 * options.blockSize / options.sampleRate;
+
+	OscLatencyHistogram blockTime;
+	double blockTimeTotal = 0.0;
+	uint64 numEvents = 0;
+
+	const double startMs = Time::getMillisecondCounterHiRes();
+	for (int block = 0; block < numBlocks; ++block)
+	{
+		midi.clear();
+		for (int i = 0; i < options.density; ++i)
+		{
+			const int mapping = random.nextInt(options.mappings);
+			const auto message = MidiMessage::noteOn(mapping / 128 + 1, mapping % 128, (uint8)(1 + random.nextInt(127)));
+			midi.addEvent(message, random.nextInt(options.blockSize));
+		}
+		numEvents += (uint64)options.density;
+
+		const auto begin = Time::getHighResolutionTicks();
+		processor->processBlock(buffer, midi);
+		const auto end = Time::getHighResolutionTicks();
+
+		blockTime.recordTicks(begin, end);
+		blockTimeTotal += Time::highResolutionTicksToSeconds(end - begin) * 1.0e6;
+
+		if (options.realtime)
+		{
+			const double due = startMs + (block + 1) * blockMs;
+			const double wait = due - Time::getMillisecondCounterHiRes();
+			if (wait > 1.0) Thread::sleep((int)wait);
+			while (Time::getMillisecondCounterHiRes() < due) {}
+		}
+	}
+	const double feedMs = Time::getMillisecondCounterHiRes() - startMs;
+
+	// DRAIN, wait until the sink has been quiet for a while
+	uint64 lastReceived = sink.numDatagrams.load();
+	for (int quiet = 0; quiet < 4; )
+	{
+		Thread::sleep(50);
+		const uint64 received = sink.numDatagrams.load();
+		quiet = received == lastReceived ? quiet + 1 : 0;
+		lastReceived = received;
+	}
+	const double elapsedMs = Time::getMillisecondCounterHiRes() - startMs;
+
+	// REPORT
+	auto& osc = processor->osc;
+	auto& destination = *osc.destinations[0];
+	auto& counters = destination.getCounters();
+
+	DynamicObject::Ptr config = new DynamicObject();
+	config->setProperty("sample_rate", options.sampleRate);
+	config->setProperty("block_size", options.blockSize);
+	config->setProperty("density", options.density);
+	config->setProperty("mappings", options.mappings);
+	config->setProperty("knobs", options.knobs);
+	config->setProperty("seconds", options.seconds);
+	config->setProperty("realtime", options.realtime);
+	config->setProperty("bundles", options.bundles);
+	config->setProperty("seed", options.seed);
+
+	DynamicObject::Ptr block = new DynamicObject();
+	const auto blockSnapshot = blockTime.getSnapshot();
+	block->setProperty("mean_us", blockTimeTotal / numBlocks);
+	block->setProperty("p50_us", blockSnapshot.p50);
+	block->setProperty("p99_us", blockSnapshot.p99);
+	block->setProperty("p999_us", blockSnapshot.p999);
+	block->setProperty("max_us", blockSnapshot.max);
+	block->setProperty("budget_us", blockMs * 1000.0);
+	block->setProperty("load", blockTimeTotal / numBlocks / (blockMs * 1000.0));
+
+	DynamicObject::Ptr drops = new DynamicObject();
+	drops->setProperty("queue", (int64)processor->eventQueue.getNumOverflows());
+	drops->setProperty("pool", (int64)osc.stats.poolDrops.load());
+	drops->setProperty("destination", (int64)destination.getNumDropped());
+	drops->setProperty("transport", (int64)counters.numDropped.load());
+	drops->setProperty("send_errors", (int64)counters.numSendErrors.load());
+
+	DynamicObject::Ptr latency = new DynamicObject();
+	latency->setProperty("queue", toJson(osc.queueLatency.getSnapshot()));
+	latency->setProperty("encode", toJson(osc.encodeLatency.getSnapshot()));
+	latency->setProperty("send", toJson(destination.sendLatency.getSnapshot()));
+	latency->setProperty("total", toJson(destination.totalLatency.getSnapshot()));
+
+	DynamicObject::Ptr result = new DynamicObject();
+	result->setProperty("config", config.get());
+	result->setProperty("blocks", numBlocks);
+	result->setProperty("events", (int64)numEvents);
+	result->setProperty("feed_ms", feedMs);
+	result->setProperty("elapsed_ms", elapsedMs);
+	result->setProperty("events_per_sec", numEvents / (feedMs / 1000.0));
+	result->setProperty("messages_encoded", (int64)osc.stats.messagesEncoded.load());
+	result->setProperty("datagrams_sent", (int64)counters.numDatagrams.load());
+	result->setProperty("datagrams_received", (int64)sink.numDatagrams.load());
+	result->setProperty("bytes_received", (int64)sink.numBytes.load());
+	result->setProperty("syscalls", (int64)counters.numSyscalls.load());
+	result->setProperty("datagrams_per_syscall", counters.getDatagramsPerSyscall());
+	result->setProperty("block", block.get());
+	result->setProperty("drops", drops.get());
+	result->setProperty("latency_us", latency.get());
+
+	processor->releaseResources();
+	processor.reset();
+
+	std::cout << JSON::toString(result.get()) << std::endl;
+	return 0;
+}
@@ -0,0 +1,459 @@
+/*
+  ==============================================================================
+
+	Main.cpp
+	Created: 17 Oct 2026 10:13:58pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+// Sends numbered messages through an OscDestination to a receiver in the same
+// process, raising the rate step by step, and checks every step for lost,
+// duplicated and reordered messages. Udp is received with juce's OSCReceiver,
+// which can't do tcp, so tcp has its own SLIP reader.
+//
+//	OscvstLoopback [--configs udp,udp+bundles,tcp,tcp+bundles] [--step-ms 1000] [--max-rate 1000000]
+
+#include <JuceHeader.h>
+#include "../../../Source/OscPacketPool.h"
+#include "../../../Source/OscDestination.h"
+
+//==============================================================================
+/*
+	Keeps track of which sequence numbers arrived in the current step. Only
+	one receiver thread records at a time, the lock is for reading results.
+*/
+class SequenceChecker
+{
+public:
+
+	struct Result
+	{
+		int received{ 0 };
+		int lost{ 0 };
+		int duplicates{ 0 };
+		int reordered{ 0 };
+		int stale{ 0 }; // from an earlier step
+	};
+
+	void reset(const int64 _base, const int count)
+	{
+		const ScopedLock sl(lock);
+		base = _base;
+		seen.assign((size_t)count, 0);
+		highest = -1;
+		result = {};
+	}
+
+	void record(const int64 sequence)
+	{
+		const ScopedLock sl(lock);
+
+		const int64 offset = sequence - base;
+		if (offset < 0 || offset >= (int64)seen.size())
+		{
+			++result.stale;
+			return;
+		}
+
+		auto& flag = seen[(size_t)offset];
+		if (flag != 0)
+		{
+			++result.duplicates;
+			return;
+		}
+		flag = 1;
+		++result.received;
+
+		if (offset < highest) ++result.reordered;
+		highest = jmax(highest, offset);
+	}
+
+	int getNumReceived() const
+	{
+		const ScopedLock sl(lock);
+		return result.received + result.duplicates + result.stale;
+	}
+
+	Result getResult(const int numSent) const
+	{
+		const ScopedLock sl(lock);
+		auto r = result;
+		r.lost = numSent - r.received;
+		return r;
+	}
+
+private:
+	CriticalSection lock;
+	int64 base{ 0 };
+	std::vector<uint8> seen;
+	int64 highest{ -1 };
+	Result result;
+};
+
+//==============================================================================
+// udp through juce's receiver, on its own thread rather than the message thread
+class UdpLoopbackReceiver : private OSCReceiver::Listener<OSCReceiver::RealtimeCallback>
+{
+public:
+
+	UdpLoopbackReceiver(SequenceChecker& _checker)
+		: checker(_checker)
+	{
+		receiver.addListener(this);
+	}
+
+	~UdpLoopbackReceiver() override
+	{
+		receiver.removeListener(this);
+		receiver.disconnect();
+	}
+
+	bool open(const int port)
+	{
+		return receiver.connect(port);
+	}
+
+private:
+	void oscMessageReceived(const OSCMessage& message) override
+	{
+		if (message.size() == 1 && message[0].isInt32())
+			checker.record((int64)(uint32)message[0].getInt32());
+	}
+
+	void oscBundleReceived(const OSCBundle& bundle) override
+	{
+		for (const auto& element : bundle)
+		{
+			if (element.isMessage())
+				oscMessageReceived(element.getMessage());
+			else
+				oscBundleReceived(element.getBundle());
+		}
+	}
+
+	SequenceChecker& checker;
+	OSCReceiver receiver{ "Oscvst loopback udp" };
+};
+
+//==============================================================================
+// tcp with SLIP framing, parses only the messages this harness sends
+class TcpLoopbackReceiver : public Thread
+{
+public:
+
+	TcpLoopbackReceiver(SequenceChecker& _checker)
+		: Thread("Oscvst loopback tcp")
+		, checker(_checker)
+	{}
+
+	~TcpLoopbackReceiver() override
+	{
+		signalThreadShouldExit();
+		listener.close();
+		stopThread(2000);
+	}
+
+	bool open(const int port)
+	{
+		if (!listener.createListener(port, "127.0.0.1")) return false;
+		startThread();
+		return true;
+	}
+
+	void run() override
+	{
+		HeapBlock<char> buffer(65536);
+
+		while (!threadShouldExit())
+		{
+			if (listener.waitUntilReady(true, 50) <= 0) continue;
+
+			std::unique_ptr<StreamingSocket> connection(listener.waitForNextConnection());
+			if (connection == nullptr) continue;
+
+			frame.clear();
+			escaped = false;
+
+			while (!threadShouldExit() && connection->isConnected())
+			{
+				const int ready = connection->waitUntilReady(true, 50);
+				if (ready < 0) break;
+				if (ready == 0) continue;
+
+				const int size = connection->read(buffer, 65536, false);
+				if (size <= 0) break;
+
+				for (int i = 0; i < size; ++i)
+					decode(buffer[i]);
+			}
+		}
+	}
+
+private:
+	void decode(const char c)
+	{
+		if (escaped)
+		{
+			frame.push_back(c == OscEncoding::slipEscEnd ? OscEncoding::slipEnd : OscEncoding::slipEsc);
+			escaped = false;
+		}
+		else if (c == OscEncoding::slipEsc)
+		{
+			escaped = true;
+		}
+		else if (c == OscEncoding::slipEnd)
+		{
+			if (!frame.empty()) parse(frame.data(), (int)frame.size());
+			frame.clear();
+		}
+		else
+		{
+			frame.push_back(c);
+		}
+	}
+
+	static int32 readInt32(const char* data)
+	{
+		const auto* d = (const uint8*)data;
+		return (int32)(((uint32)d[0] << 24) | ((uint32)d[1] << 16) | ((uint32)d[2] << 8) | (uint32)d[3]);
+	}
+
+	void parse(const char* data, const int size)
+	{
+		if (size >= OscEncoding::bundleHeaderSize && std::memcmp(data, "#bundle", 8) == 0)
+		{
+			int pos = OscEncoding::bundleHeaderSize;
+			while (pos + OscEncoding::elementHeaderSize <= size)
+			{
+				const int elementSize = readInt32(data + pos);
+				pos += OscEncoding::elementHeaderSize;
+				if (elementSize <= 0 || pos + elementSize > size) return;
+
+				parse(data + pos, elementSize);
+				pos += elementSize;
+			}
+			return;
+		}
+
+		// address, ",i", one int
+		const auto addressSize = (int)strnlen(data, (size_t)size);
+		const int typeTagsOffset = OscEncoding::getPaddedSize(addressSize);
+		const int argOffset = typeTagsOffset + OscEncoding::getPaddedSize(2);
+		if (argOffset + 4 > size || std::memcmp(data + typeTagsOffset, ",i", 2) != 0) return;
+
+		checker.record((int64)(uint32)readInt32(data + argOffset));
+	}
+
+	SequenceChecker& checker;
+	StreamingSocket listener;
+	std::vector<char> frame;
+	bool escaped{ false };
+};
+
+//==============================================================================
+struct LoopbackConfig
+{
+	String name;
+	OscDestination::Protocol protocol;
+	bool bundles;
+
+	static bool fromName(const String& name, LoopbackConfig& config)
+	{
+		config.name = name;
+		config.bundles = name.endsWith("+bundles");
+
+		const String protocol = name.upToFirstOccurrenceOf("+", false, false);
+		if (protocol == "udp") config.protocol = OscDestination::Protocol::Udp;
+		else if (protocol == "tcp") config.protocol = OscDestination::Protocol::Tcp;
+		else return false;
+
+		return true;
+	}
+};
+
+struct StepResult
+{
+	String config;
+	int rate;
+	int sent;
+	int senderDrops; // pool or destination queue full, never reached the socket
+	SequenceChecker::Result result;
+
+	bool isClean() const
+	{
+		return senderDrops == 0 && result.lost == 0 && result.duplicates == 0 && result.reordered == 0;
+	}
+};
+
+//==============================================================================
+/*
+	Paces the messages out in 1ms slices, the same way the dispatch thread
+	hands them to a destination, then waits for the receiver to go quiet.
+*/
+static StepResult runStep(OscDestination& destination, OscPacketPool& pool, SequenceChecker& checker
+	, const LoopbackConfig& config, const int rate, const int stepMs, int64& nextSequence)
+{
+	const int count = jmax(1, (int)((int64)rate * stepMs / 1000));
+	checker.reset(nextSequence, count);
+
+	// "/oscvst/seq" ",i" then the number
+	char message[20];
+	const int argOffset = OscEncoding::writeString(message, "/oscvst/seq", 11);
+	OscEncoding::writeString(message + argOffset, ",i", 2);
+	const int messageSize = argOffset + 8;
+
+	StepResult step{ config.name, rate, count, 0, {} };
+	const uint32 droppedBefore = destination.getNumDropped();
+
+	const double startMs = Time::getMillisecondCounterHiRes();
+	int sent = 0;
+	while (sent < count)
+	{
+		const double elapsedMs = Time::getMillisecondCounterHiRes() - startMs;
+		const int due = jmin(count, (int)(rate * (elapsedMs + 1.0) / 1000.0));
+
+		for (; sent < due; ++sent)
+		{
+			OscEncoding::writeInt32(message + argOffset + 4, (int32)(uint32)(nextSequence + sent));
+
+			const int index = pool.acquire(message, messageSize);
+			if (index < 0)
+			{
+				++step.senderDrops;
+				continue;
+			}
+			destination.enqueue(index);
+			pool.release(index);
+		}
+		destination.wake();
+
+		Thread::sleep(1);
+	}
+	nextSequence += count;
+
+	// DRAIN, tcp may still be working through its buffer
+	int lastReceived = checker.getNumReceived();
+	for (int quiet = 0, waited = 0; quiet < 5 && waited < 10000; waited += 50)
+	{
+		Thread::sleep(50);
+		const int received = checker.getNumReceived();
+		quiet = received == lastReceived ? quiet + 1 : 0;
+		lastReceived = received;
+	}
+
+	step.senderDrops += (int)(destination.getNumDropped() - droppedBefore);
+	step.result = checker.getResult(count);
+	return step;
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	ArgumentList args(argc, argv);
+	if (args.containsOption("--help|-h"))
+	{
+		std::cout << "OscvstLoopback [--configs udp,udp+bundles,tcp,tcp+bundles] [--step-ms 1000]\n"
+			"               [--max-rate 1000000] [--port 9123] [--keep-going] [--json]\n";
+		return 0;
+	}
+
+	auto get = [&args](const char* option, const String& fallback)
+	{
+		return args.containsOption(option) ? args.getValueForOption(option) : fallback;
+	};
+
+	const auto configNames = StringArray::fromTokens(get("--configs", "udp,udp+bundles,tcp,tcp+bundles"), ",", "");
+	const int stepMs = jmax(100, get("--step-ms", "1000").getIntValue());
+	const int maxRate = jmax(1, get("--max-rate", "1000000").getIntValue());
+	const int port = get("--port", "9123").getIntValue();
+	const bool keepGoing = args.containsOption("--keep-going");
+	const bool asJson = args.containsOption("--json");
+
+	// RECEIVERS, udp and tcp on the same port number
+	SequenceChecker checker;
+	UdpLoopbackReceiver udpReceiver(checker);
+	TcpLoopbackReceiver tcpReceiver(checker);
+	if (!udpReceiver.open(port) || !tcpReceiver.open(port))
+	{
+		std::cerr << "couldn't listen on port " << port << "\n";
+		return 1;
+	}
+
+	std::vector<StepResult> steps;
+	Array<var> summary;
+
+	for (const auto& configName : configNames)
+	{
+		LoopbackConfig config;
+		if (!LoopbackConfig::fromName(configName.trim(), config))
+		{
+			std::cerr << "unknown config " << configName << ", expected udp or tcp with an optional +bundles\n";
+			return 1;
+		}
+
+		OscPacketPool pool(4096);
+		OscDestination destination(pool);
+		destination.setProtocol(config.protocol);
+		destination.setBundling(config.bundles, destination.mtu);
+		destination.setAddress("127.0.0.1", port);
+		destination.start(false, 0);
+
+		int64 nextSequence = 0;
+		int sustainable = 0;
+
+		for (int rate = 1000; rate <= maxRate; rate = rate * 2 + rate / 2)
+		{
+			steps.push_back(runStep(destination, pool, checker, config, rate, stepMs, nextSequence));
+			const auto& step = steps.back();
+
+			if (!asJson)
+			{
+				std::cout << config.name.paddedRight(' ', 14) << String(rate).paddedLeft(' ', 9) << "/s"
+					<< "  lost " << step.result.lost << "  dup " << step.result.duplicates
+					<< "  reordered " << step.result.reordered << "  sender drops " << step.senderDrops << "\n";
+			}
+
+			if (step.isClean())
+				sustainable = jmax(sustainable, rate);
+			else if (!keepGoing)
+				break;
+		}
+
+		DynamicObject::Ptr o = new DynamicObject();
+		o->setProperty("config", config.name);
+		o->setProperty("max_rate_without_loss", sustainable);
+		summary.add(o.get());
+
+		if (!asJson)
+			std::cout << config.name << ": " << sustainable << " messages/s without loss\n\n";
+	}
+
+	if (asJson)
+	{
+		Array<var> stepList;
+		for (const auto& step : steps)
+		{
+			DynamicObject::Ptr o = new DynamicObject();
+			o->setProperty("config", step.config);
+			o->setProperty("rate", step.rate);
+			o->setProperty("sent", step.sent);
+			o->setProperty("received", step.result.received);
+			o->setProperty("lost", step.result.lost);
+			o->setProperty("duplicates", step.result.duplicates);
+			o->setProperty("reordered", step.result.reordered);
+			o->setProperty("stale", step.result.stale);
+			o->setProperty("sender_drops", step.senderDrops);
+			stepList.add(o.get());
+		}
+
+		DynamicObject::Ptr result = new DynamicObject();
+		result->setProperty("step_ms", stepMs);
+		result->setProperty("steps", stepList);
+		result->setProperty("summary", summary);
+		std::cout << JSON::toString(result.get()) << std::endl;
+	}
+
+	return 0;
+}
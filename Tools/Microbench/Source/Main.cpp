@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+	Main.cpp
+	Created: 17 Oct 2026 9:41:27pm
+	Author:  pat
+
+  ==============================================================================
+*/
+
+// Times the pieces of the dispatch hot path on their own, in nanoseconds per
+// call, with 1, 4 and 16 knobs in use. The juce OSCMessage rows are what the
+// plugin used to do per note, kept to compare the compiled messages against.
+// The send rows include a real UDP write to a local socket, juce's OSCSender
+// against writing the compiled message straight to a DatagramSocket.
+//
+//	OscvstMicrobench [--json] [--filter render]
+
+#include <JuceHeader.h>
+#include "../../../Source/OscObject.h"
+#include "../../../Source/OscDispatchTable.h"
+
+//==============================================================================
+namespace
+{
+	// results are folded in here so the optimiser can't drop the work
+	volatile uint32 sink = 0;
+
+	/*
+		Calibrates the number of iterations until one run takes at least 20ms,
+		then returns the fastest of 5 runs in nanoseconds per call.
+	*/
+	template <typename Function>
+	double measure(Function&& function)
+	{
+		auto run = [&function](const int64 iterations)
+		{
+			const auto start = Time::getHighResolutionTicks();
+			for (int64 i = 0; i < iterations; ++i)
+				function(i);
+			return Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+		};
+
+		int64 iterations = 1000;
+		while (run(iterations) < 0.02 && iterations < ((int64)1 << 40))
+			iterations *= 2;
+
+		double best = std::numeric_limits<double>::max();
+		for (int i = 0; i < 5; ++i)
+			best = jmin(best, run(iterations));
+
+		return best * 1.0e9 / (double)iterations;
+	}
+
+	// a note mapping sending note, velocity and the first numKnobs knobs as floats
+	OscObject makeObject(const int numKnobs)
+	{
+		OscObject oscObject(1, 60, "/oscvst/bench/note");
+		for (int k = 0; k < numKnobs; ++k)
+		{
+			oscObject.knobRanges[(size_t)k].inUse = true;
+			oscObject.knobRanges[(size_t)k].range = { -1.0f, 1.0f };
+		}
+		oscObject.compile();
+		return oscObject;
+	}
+
+	std::array<float, 16> makeKnobValues()
+	{
+		std::array<float, 16> knobValues;
+		for (int k = 0; k < 16; ++k)
+			knobValues[(size_t)k] = k / 16.0f;
+		return knobValues;
+	}
+
+	// lays the message out the way OSCSender does, its encoder is private so this only
+	// covers the layout, the real thing is timed by juce_sender_send
+	int serialise(const OSCMessage& message, char* dest)
+	{
+		char* data = dest;
+
+		const String address = message.getAddressPattern().toString();
+		data += OscEncoding::writeString(data, address.toRawUTF8(), (int)address.getNumBytesAsUTF8());
+
+		String typeTags(",");
+		for (const auto& arg : message)
+			typeTags += arg.getType();
+		data += OscEncoding::writeString(data, typeTags.toRawUTF8(), typeTags.length());
+
+		for (const auto& arg : message)
+		{
+			if (arg.isInt32())
+				OscEncoding::writeInt32(data, arg.getInt32());
+			else if (arg.isFloat32())
+				OscEncoding::writeFloat32(data, arg.getFloat32());
+			data += 4;
+		}
+
+		return (int)(data - dest);
+	}
+}
+
+//==============================================================================
+struct BenchmarkResult
+{
+	String name;
+	int knobs;
+	double nanoseconds;
+};
+
+int main(int argc, char* argv[])
+{
+	ArgumentList args(argc, argv);
+	if (args.containsOption("--help|-h"))
+	{
+		std::cout << "OscvstMicrobench [--json] [--filter <name>]\n";
+		return 0;
+	}
+
+	const bool asJson = args.containsOption("--json");
+	const String filter = args.containsOption("--filter") ? args.getValueForOption("--filter") : String();
+
+	std::vector<BenchmarkResult> results;
+
+	auto add = [&](const String& name, const int knobs, std::function<double()> benchmark)
+	{
+		if (filter.isNotEmpty() && !name.contains(filter)) return;
+		results.push_back({ name, knobs, benchmark() });
+	};
+
+	auto knobValues = makeKnobValues();
+
+	for (const int numKnobs : { 1, 4, 16 })
+	{
+		// RANGE MAPPING, every knob in use once, as render does
+		add("range_get_value", numKnobs, [&]()
+		{
+			auto oscObject = makeObject(numKnobs);
+			return measure([&](const int64 i)
+			{
+				float total = 0.0f;
+				for (int k = 0; k < numKnobs; ++k)
+					total += oscObject.knobRanges[(size_t)k].getValue(knobValues[(size_t)k] + (float)(i & 1));
+				sink = sink + (uint32)total;
+			});
+		});
+
+		// ARGUMENT ASSEMBLY, patching the values into the compiled message
+		add("render", numKnobs, [&]()
+		{
+			auto oscObject = makeObject(numKnobs);
+			return measure([&](const int64 i)
+			{
+				knobValues[(size_t)(i & 15)] = (float)(i & 127) / 127.0f;
+				const char* data = oscObject.render((float)(i & 127) / 127.0f, knobValues);
+				sink = sink + (uint8)data[oscObject.getEncodedSize() - 1];
+			});
+		});
+
+		// JUCE MESSAGE, building an OSCMessage per note and laying it out
+		add("juce_message_construct", numKnobs, [&]()
+		{
+			auto oscObject = makeObject(numKnobs);
+			return measure([&](const int64 i)
+			{
+				OSCMessage message(oscObject.path);
+				message.addInt32(oscObject.note);
+				message.addFloat32((float)(i & 127) / 127.0f);
+				for (int k = 0; k < numKnobs; ++k)
+					message.addFloat32(oscObject.knobRanges[(size_t)k].getValue(knobValues[(size_t)k]));
+				sink = sink + (uint32)message.size();
+			});
+		});
+
+		add("juce_message_layout", numKnobs, [&]()
+		{
+			auto oscObject = makeObject(numKnobs);
+			std::vector<char> buffer(1024);
+			return measure([&](const int64 i)
+			{
+				OSCMessage message(oscObject.path);
+				message.addInt32(oscObject.note);
+				message.addFloat32((float)(i & 127) / 127.0f);
+				for (int k = 0; k < numKnobs; ++k)
+					message.addFloat32(oscObject.knobRanges[(size_t)k].getValue(knobValues[(size_t)k]));
+				sink = sink + (uint32)serialise(message, buffer.data());
+			});
+		});
+
+		// SEND, to a local socket that never reads, the kernel drops what doesn't fit
+		add("juce_sender_send", numKnobs, [&]()
+		{
+			auto oscObject = makeObject(numKnobs);
+			DatagramSocket receiver;
+			OSCSender sender;
+			if (!receiver.bindToPort(0, "127.0.0.1") || !sender.connect("127.0.0.1", receiver.getBoundPort()))
+				return 0.0;
+
+			return measure([&](const int64 i)
+			{
+				OSCMessage message(oscObject.path);
+				message.addInt32(oscObject.note);
+				message.addFloat32((float)(i & 127) / 127.0f);
+				for (int k = 0; k < numKnobs; ++k)
+					message.addFloat32(oscObject.knobRanges[(size_t)k].getValue(knobValues[(size_t)k]));
+				sink = sink + (uint32)sender.send(message);
+			});
+		});
+
+		add("compiled_send", numKnobs, [&]()
+		{
+			auto oscObject = makeObject(numKnobs);
+			DatagramSocket receiver, socket;
+			if (!receiver.bindToPort(0, "127.0.0.1"))
+				return 0.0;
+			const int port = receiver.getBoundPort();
+
+			return measure([&](const int64 i)
+			{
+				const char* data = oscObject.render((float)(i & 127) / 127.0f, knobValues);
+				sink = sink + (uint32)socket.write("127.0.0.1", port, data, oscObject.getEncodedSize());
+			});
+		});
+	}
+
+	// LOOKUP, a full map of every channel and note, plus any channel mappings
+	{
+		MidiOscMap oscMap;
+		for (int channel = 0; channel <= 16; ++channel)
+			for (int note = 0; note < 128; note += (channel == 0 ? 1 : 3))
+				oscMap.emplace(getMidiOscKey(channel, note), OscObject(channel, note, "/oscvst"));
+
+		OscDispatchTable<OscObject> table;
+		table.rebuild(oscMap);
+
+		// what dispatch used to do, the channel specific mapping then the any channel one
+		add("map_lookup", 0, [&]()
+		{
+			return measure([&](const int64 i)
+			{
+				const int channel = (int)(i & 15) + 1;
+				const int note = (int)((i * 7) & 127);
+
+				auto it = oscMap.find(getMidiOscKey(channel, note));
+				if (it == oscMap.end()) it = oscMap.find(getMidiOscKey(0, note));
+				sink = sink + (uint32)(it != oscMap.end() ? it->second.note : 0);
+			});
+		});
+
+		add("dispatch_table_lookup", 0, [&]()
+		{
+			return measure([&](const int64 i)
+			{
+				const auto* oscObject = table.find((int)(i & 15) + 1, (int)((i * 7) & 127));
+				sink = sink + (uint32)(oscObject != nullptr ? oscObject->note : 0);
+			});
+		});
+	}
+
+	// REPORT
+	if (asJson)
+	{
+		Array<var> list;
+		for (const auto& r : results)
+		{
+			DynamicObject::Ptr o = new DynamicObject();
+			o->setProperty("name", r.name);
+			o->setProperty("knobs", r.knobs);
+			o->setProperty("ns_per_call", r.nanoseconds);
+			list.add(o.get());
+		}
+		std::cout << JSON::toString(list) << std::endl;
+	}
+	else
+	{
+		std::cout << String("benchmark").paddedRight(' ', 26) << String("knobs").paddedLeft(' ', 6) << String("ns/call").paddedLeft(' ', 12) << "\n";
+		for (const auto& r : results)
+		{
+			std::cout << r.name.paddedRight(' ', 26)
+				<< (r.knobs > 0 ? String(r.knobs) : String("-")).paddedLeft(' ', 6)
+				<< String(r.nanoseconds, 1).paddedLeft(' ', 12) << "\n";
+		}
+	}
+
+	return 0;
+}
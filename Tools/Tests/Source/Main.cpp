@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+	Main.cpp
+	Created: 18 Oct 2026 2:04:11am
+	Author:  pat
+
+  ==============================================================================
+*/
+
+// Runs every juce::UnitTest linked in, exits with 1 if any of them failed.
+//
+//	OscvstTests [--category oscvst]
+
+#include <JuceHeader.h>
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	const StringArray args(argv + 1, argc - 1);
+	const int categoryIndex = args.indexOf("--category");
+
+	UnitTestRunner runner;
+	runner.setAssertOnFailure(false);
+
+	if (categoryIndex >= 0 && categoryIndex + 1 < args.size())
+		runner.runTestsInCategory(args[categoryIndex + 1]);
+	else
+		runner.runAllTests();
+
+	int failures = 0;
+	for (int i = 0; i < runner.getNumResults(); ++i)
+		failures += runner.getResult(i)->failures;
+
+	return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+	OscEventQueueTests.cpp
+	Created: 18 Oct 2026 2:41:12am
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/OscEventQueue.h"
+
+//==============================================================================
+class OscEventQueueTests : public UnitTest
+{
+public:
+
+	OscEventQueueTests() : UnitTest("OscEventQueue", "oscvst") {}
+
+	void runTest() override
+	{
+		beginTest("coalesced events go back in ahead of newer ones");
+		{
+			OscEventQueue queue;
+			queue.prepare(2);
+			queue.setOverflowPolicy(OscEventQueue::OverflowPolicy::Coalesce);
+
+			queue.push(OscEvent::noteOn(1, 1, 1.0f, 0));
+			queue.push(OscEvent::noteOn(1, 2, 1.0f, 0));
+			queue.push(OscEvent::noteOn(1, 3, 0.25f, 0)); // full, held back
+			queue.push(OscEvent::noteOn(1, 3, 0.5f, 0)); // replaces it
+
+			OscEvent e;
+			queue.pop(e);
+			queue.push(OscEvent::noteOn(1, 4, 1.0f, 0)); // the held back one takes the free slot first
+
+			Array<int> order;
+			while (queue.pop(e))
+			{
+				order.add(e.note);
+				if (e.note == 3) expectEquals(e.value, 0.5f);
+			}
+			expect(queue.flushCoalesced());
+			while (queue.pop(e)) order.add(e.note);
+
+			expect(order == Array<int>{ 2, 3, 4 });
+			expectEquals((int)queue.getNumOverflows(), 3);
+		}
+
+		beginTest("nothing is coalesced while there is room");
+		{
+			OscEventQueue queue;
+			queue.prepare(4);
+			queue.setOverflowPolicy(OscEventQueue::OverflowPolicy::Coalesce);
+
+			for (int i = 0; i < 4; ++i)
+				queue.push(OscEvent::noteOn(1, 7, (float)i / 4.0f, 0));
+
+			expectEquals(queue.getNumReady(), 4);
+			expect(!queue.flushCoalesced());
+			expectEquals((int)queue.getNumOverflows(), 0);
+		}
+	}
+};
+
+static OscEventQueueTests oscEventQueueTests;
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+	OscTimingWheelTests.cpp
+	Created: 18 Oct 2026 2:06:38am
+	Author:  pat
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/OscTimingWheel.h"
+
+//==============================================================================
+class OscTimingWheelTests : public UnitTest
+{
+public:
+
+	OscTimingWheelTests() : UnitTest("OscTimingWheel", "oscvst") {}
+
+	void runTest() override
+	{
+		beginTest("the next wake up counts entries on the higher levels");
+		{
+			OscTimingWheel<int> wheel(16);
+			wheel.clear(0);
+			wheel.insert(0x205, 1); // beyond the first turn, waits on level 1
+			wheel.advance(0x1f0, [](int) {});
+			wheel.insert(0x2e0, 2); // due later, but straight into level 0
+
+			// level 0 turns over at 0x200 and brings the first one down
+			expectEquals(wheel.getTicksUntilNext(), (int64)0x10);
+
+			int64 tick = 0x1f0;
+			int64 firedAt = 0;
+			while (firedAt == 0)
+			{
+				tick += wheel.getTicksUntilNext();
+				wheel.advance(tick, [&](int v) { if (v == 1) firedAt = tick; });
+			}
+			expectEquals(firedAt, (int64)0x205);
+		}
+
+		beginTest("entries due on the same tick keep their order through a cascade");
+		{
+			OscTimingWheel<int> wheel(16);
+			wheel.clear(0);
+			wheel.insert(0x300, 1); // level 1
+			wheel.advance(0x250, [](int) {});
+			wheel.insert(0x300, 2); // straight into level 0, after the one above
+
+			Array<int> order;
+			wheel.advance(0x300, [&](int v) { order.add(v); });
+			expect(order == Array<int>{ 1, 2 });
+		}
+
+		beginTest("two levels turning over on the same tick keep their order");
+		{
+			OscTimingWheel<int> wheel(16);
+			wheel.clear(0);
+			wheel.insert(0x10005, 1); // level 2
+			wheel.advance(0x100, [](int) {});
+			wheel.insert(0x10005, 2); // level 1
+			wheel.advance(0xfff0, [](int) {});
+			wheel.insert(0x10005, 3); // level 0
+
+			Array<int> order;
+			wheel.advance(0x10005, [&](int v) { order.add(v); });
+			expect(order == Array<int>{ 1, 2, 3 });
+		}
+
+		beginTest("nothing comes out early or late");
+		{
+			OscTimingWheel<int> wheel(4096);
+			Random random(1234);
+			std::multimap<int64, int> expected;
+			int64 tick = 0;
+			int bad = 0;
+
+			for (int i = 0; i < 20000; ++i)
+			{
+				if (wheel.getNumPending() < 4000)
+				{
+					const int64 due = tick + 1 + random.nextInt(random.nextBool() ? 300 : 100000);
+					if (wheel.insert(due, i)) expected.insert({ due, i });
+				}
+
+				const int64 next = wheel.getTicksUntilNext();
+				tick += next > 0 ? jmin(next, (int64)1 + random.nextInt(50)) : 1;
+				wheel.advance(tick, [&](int v)
+				{
+					auto it = expected.begin();
+					if (it == expected.end() || it->first != tick || it->second != v) ++bad;
+					else expected.erase(it);
+				});
+
+				// everything due by now must have come out
+				if (!expected.empty() && expected.begin()->first <= tick) ++bad;
+			}
+
+			expectEquals(bad, 0);
+		}
+	}
+};
+
+static OscTimingWheelTests oscTimingWheelTests;